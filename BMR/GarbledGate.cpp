@@ -40,6 +40,14 @@ void GarbledGate::compute_prfs_outputs(const Register** in_wires, int my_id,
 {
     int n_parties = CommonParty::get_n_parties();
     init_inputs(g, n_parties);
+    // both extensions in one batch per key,
+    // buffers are reused because this runs for every gate
+    static thread_local vector<Key> inputs, outputs;
+    inputs.resize(2 * n_parties);
+    outputs.resize(2 * n_parties);
+    for (int e=0; e<=1; e++)
+        for (int j=1; j<= n_parties; j++)
+            inputs[e * n_parties + j - 1] = *(Key*)input(e, j);
     for(int w=0; w<=1; w++) {
         for (int b=0; b<=1; b++) {
             const Key& key = in_wires[w]->key(my_id, b);
@@ -48,10 +56,12 @@ void GarbledGate::compute_prfs_outputs(const Register** in_wires, int my_id,
 #ifdef DEBUG
             cout << "using key " << key << endl;
 #endif
+            PRF_blocks((octet*) rd_key, &inputs[0].r, &outputs[0].r,
+                    2 * n_parties);
             for (int e=0; e<=1; e++) {
                 for (int j=1; j<= n_parties; j++) {
                     prf_output[j-1].outputs[w][b][e][0] =
-                            aes_128_encrypt(*(__m128i*)input(e, j), (octet*)rd_key);
+                            outputs[e * n_parties + j - 1].r;
                 }
             }
         }
@@ -10,25 +10,30 @@
 
 #include "Tools/aes.h"
 
+// encrypts in blocks of up to eight to make use of pipelining
+inline void PRF_blocks(const octet* rd_key, const __m128i* in, __m128i* out,
+		int number)
+{
+	int i = 0;
+	for (; i + 8 <= number; i += 8)
+		ecb_aes_128_encrypt<8>(out + i, in + i, rd_key);
+	switch (number - i)
+	{
+#define X(N) case N: ecb_aes_128_encrypt<N>(out + i, in + i, rd_key); break;
+	X(1) X(2) X(3) X(4) X(5) X(6) X(7)
+#undef X
+	default:
+		break;
+	}
+}
+
 inline void PRF_chunk(const Key& key, char* input, char* output, int number)
 {
 	__m128i* in = (__m128i*)input;
 	__m128i* out = (__m128i*)output;
 	__m128i rd_key[15];
 	aes_128_schedule((octet*) rd_key, (unsigned char*)&key.r);
-	switch (number)
-	{
-	case 2:
-		ecb_aes_128_encrypt<2>(out, in, (octet*)rd_key);
-		break;
-	case 3:
-		ecb_aes_128_encrypt<3>(out, in, (octet*)rd_key);
-		break;
-	default:
-		for (int i = 0; i < number; i++)
-			ecb_aes_128_encrypt<1>(&out[i], &in[i], (octet*)rd_key);
-		break;
-	}
+	PRF_blocks((octet*) rd_key, in, out, number);
 }
 
 #endif /* PROTOCOL_INC_PRF_H_ */
@@ -864,8 +864,7 @@ class sbitvec(_vec, _bit, _binary):
         if length:
             assert isinstance(elements, sint)
             if Program.prog.use_split():
-                x = elements.split_to_two_summands(length)
-                v = sbitint.bit_adder(x[0], x[1])
+                v = comparison.SplitBitDecRaw(elements, length)
             else:
                 prog = Program.prog
                 if not prog.options.ring:
@@ -0,0 +1,355 @@
+"""
+This module implements the persistent compilation cache used with
+``compile.py --cache``. The program itself is always executed, but
+the optimization of a tape (merging, CISC expansion, and register
+allocation) is skipped if an earlier compilation has seen a tape with
+the same instructions, block structure, program settings, and
+options. An entry holds the optimized bytecode of the tape without the
+trailing requirement instructions, its contribution to the
+requirement tree per node, the final numbers of registers referenced
+by other tapes, and the tapes created while expanding CISC
+instructions. Tapes whose optimization changes memory allocation or
+calls tapes outside of the entry are not cached.
+"""
+
+import hashlib
+import os
+import pickle
+import sys
+import tempfile
+
+from .program import Tape
+from . import instructions
+
+CACHE_VERSION = 2
+MAX_ENTRIES = 1024
+
+
+def hash_file(filename):
+    h = hashlib.sha256()
+    with open(filename, "rb") as f:
+        for chunk in iter(lambda: f.read(1 << 20), b""):
+            h.update(chunk)
+    return h.hexdigest()
+
+
+class CachedCode:
+    """Optimized bytecode of a tape as a single pseudo-instruction."""
+
+    def __init__(self, code):
+        self.code = code
+
+    def get_bytes(self):
+        return self.code
+
+
+class CachedBlock:
+    """Stand-in for the optimized basic blocks of a tape that were
+    restored from the cache. Blocks without code only carry the
+    requirements of their node."""
+
+    def __init__(self, name, req_node, usage, code=None, size=0):
+        self.name = name
+        self.req_node = req_node
+        self.usage = Tape.ReqNum(usage)
+        self.instructions = []
+        self.extra = 0
+        if code is not None:
+            self.instructions.append(CachedCode(code))
+            self.extra = size - 1
+        self.purged = False
+
+    def __len__(self):
+        return len(self.instructions) + self.extra
+
+    def add_usage(self, req_node):
+        req_node.num += self.usage
+
+    def purge(self, retain_usage=True):
+        self.extra = len(self)
+        self.instructions = []
+        self.purged = True
+
+
+class TapeCache:
+    # program settings that influence the optimization
+    settings = ("bit_length", "_security", "prime", "use_trunc_pr",
+                "use_dabit", "_edabit", "_invperm", "_split", "_square",
+                "_always_raw", "_linear_rounds", "cisc_to_function",
+                "use_tape_calls", "force_cisc_tape", "n_running_threads",
+                "budget", "galois_length")
+
+    def __init__(self, program):
+        self.program = program
+        self.dir = program.programs_dir + "/Cache"
+        compiler_dir = os.path.dirname(os.path.abspath(__file__))
+        h = hashlib.sha256()
+        h.update(repr((CACHE_VERSION, sys.version_info[:2])).encode())
+        for root, dirs, files in sorted(os.walk(compiler_dir)):
+            dirs.sort()
+            for filename in sorted(files):
+                if filename.endswith(".py"):
+                    path = os.path.join(root, filename)
+                    h.update(os.path.relpath(path, compiler_dir).encode())
+                    h.update(hash_file(path).encode())
+        self.compiler_hash = h.digest()
+        if os.path.isdir(self.dir):
+            self.prune()
+
+    def compute_key(self, tape):
+        """Hash the unoptimized tape. Also determines which registers
+        other tapes can refer to and which tapes are called, and
+        starts recording the program-wide effects of the
+        optimization."""
+        program = self.program
+        h = hashlib.sha256(self.compiler_hash)
+
+        def add(*args):
+            for x in args:
+                h.update(str(x).encode())
+                h.update(b"\0")
+
+        options = vars(program.options)
+        for name in sorted(options):
+            if not name.startswith("_") and name not in ("cache", "profile"):
+                add(name, options[name])
+        for name in self.settings:
+            add(name, getattr(program, name, None))
+        add(len(program.tapes), tape.merge_opens, tape.singular,
+            sorted(tape.req_bit_length.items()))
+
+        nodes = []
+        node_index = {}
+        pools = {}
+        groups = {}
+
+        def describe_reg(reg):
+            if reg.program is not tape:
+                return "%s@%s" % (reg, reg.program.name)
+            res = str(reg)
+            if reg.vectorbase is not reg:
+                res += "<%s" % reg.vectorbase
+            if len(reg.duplicates) > 1:
+                if id(reg) not in groups:
+                    for dup in reg.duplicates:
+                        groups[id(dup)] = len(groups)
+                res += "=%d" % groups[id(reg)]
+            if not reg.can_eliminate:
+                res += "!"
+            return res
+
+        def describe(x):
+            if isinstance(x, Tape.Register):
+                return describe_reg(x)
+            elif isinstance(x, (list, tuple)):
+                return "[%s]" % ",".join(describe(y) for y in x)
+            else:
+                return str(x)
+
+        called = set()
+        exported = list(tape.return_values)
+
+        def add_instruction(inst):
+            args = getattr(inst, "calls", None) or inst.args
+            pre = inst.get_pre_arg() if hasattr(inst, "get_pre_arg") else ""
+            add(type(inst).__name__, pre, describe(args))
+            if isinstance(inst, instructions.call_tape):
+                callee = program.tapes[inst.args[0]]
+                if callee.cache_key is None:
+                    return False
+                called.add(inst.args[0])
+                add(callee.cache_key)
+            elif isinstance(inst, instructions.call_arg):
+                exported.append(inst.args[0])
+            return True
+
+        blocks = dict((id(block), i)
+                      for i, block in enumerate(tape.basicblocks))
+
+        def block_index(block):
+            if block is None:
+                return -1
+            return blocks.get(id(block), "?")
+
+        for block in tape.basicblocks:
+            if id(block.req_node) not in node_index:
+                node_index[id(block.req_node)] = len(nodes)
+                nodes.append(block.req_node)
+            add(node_index[id(block.req_node)],
+                pools.setdefault(id(block.alloc_pool), len(pools)),
+                block_index(block.scope), block_index(block.exit_block),
+                block_index(block.previous_block),
+                block_index(getattr(block, "sub_block", None)),
+                len(block.instructions))
+            if block.exit_condition is not None:
+                if not add_instruction(block.exit_condition):
+                    return None
+            for inst in block.instructions:
+                if not add_instruction(inst):
+                    return None
+        add(describe(tape.return_values))
+        add(describe([addr for addr in program.base_addresses
+                      if addr.program == tape]))
+
+        tape.cache_info = dict(
+            nodes=nodes, node_index=node_index, called=called,
+            exported=exported, n_tapes=len(program.tapes),
+            tape_counter=program.tape_counter,
+            allocated_mem=dict(program.allocated_mem), saved=program.saved,
+            used_security=program.used_security,
+            relevant_opts=program.relevant_opts,
+            always_active=program._always_active)
+        # record only what the optimization adds to these
+        program.used_security = 0
+        program.relevant_opts = set()
+        program._always_active = True
+        return h.hexdigest()
+
+    def merge_effects(self, info, used_security, relevant_opts,
+                      always_active):
+        program = self.program
+        program.used_security = max(info["used_security"], used_security)
+        program.relevant_opts = info["relevant_opts"] | relevant_opts
+        program._always_active = info["always_active"] and always_active
+
+    def restore(self, tape):
+        """Replace the unoptimized blocks of a tape by cached code if
+        available. Returns whether that was the case."""
+        tape.cache_key = self.compute_key(tape)
+        if tape.cache_key is None:
+            return False
+        filename = self.dir + "/" + tape.cache_key
+        try:
+            with open(filename, "rb") as f:
+                entry = pickle.load(f)
+        except (OSError, EOFError, ValueError, pickle.UnpicklingError):
+            return False
+        os.utime(filename)
+
+        program = self.program
+        info = tape.cache_info
+        for reg, i in zip(info["exported"], entry["exported"]):
+            reg.i = i
+        for child in entry["tapes"]:
+            # reproduce the names of a fresh compilation
+            program.tape_counter = info["tape_counter"] + child["counter"]
+            name = child["name"]
+            if child["prefixed"]:
+                name = program.name + "-" + name
+            new = Tape(name, program)
+            program.tapes.append(new)
+            new.cache_key = child["key"]
+            new.req_bit_length.update(child["req_bit_length"])
+            new.basicblocks = [CachedBlock(new.name, new.req_tree,
+                                           child["usage"], child["code"],
+                                           child["size"])]
+            new.req_tree.add_block(new.basicblocks[0])
+            new.write_bytes()
+            new.purge()
+        program.tape_counter = info["tape_counter"] + entry["tape_counter"]
+        self.merge_effects(info, entry["used_security"],
+                           entry["relevant_opts"], entry["always_active"])
+        tape.req_bit_length.update(entry["req_bit_length"])
+
+        blocks = [CachedBlock(tape.name, info["nodes"][i], usage)
+                  for i, usage in entry["usage"]]
+        blocks.append(CachedBlock(tape.name, tape.req_tree, {},
+                                  entry["code"], entry["size"]))
+        tape.basicblocks = blocks
+        del tape.cache_info
+        print("Using cached optimization of tape", tape.name)
+        return True
+
+    def store(self, tape):
+        """Store the optimized code of a tape. Must be called before
+        the requirement instructions are added."""
+        if tape.cache_key is None:
+            return
+        program = self.program
+        info = tape.cache_info
+        del tape.cache_info
+        effects = dict(used_security=program.used_security,
+                       relevant_opts=program.relevant_opts,
+                       always_active=program._always_active)
+        self.merge_effects(info, **effects)
+        if dict(program.allocated_mem) != info["allocated_mem"] or \
+           program.saved != info["saved"]:
+            return self.skip(tape, "memory allocation")
+
+        new_tapes = range(info["n_tapes"], len(program.tapes))
+        code = []
+        called = set()
+        for inst in tape._get_instructions():
+            if inst is not None:
+                code.append(inst.get_bytes())
+                if isinstance(inst, instructions.call_tape):
+                    called.add(inst.args[0])
+        if not called <= info["called"] | set(new_tapes):
+            return self.skip(tape, "calls to shared tapes")
+
+        usage = {}
+        for block in tape.basicblocks:
+            node = Tape.ReqNode("")
+            node.num = Tape.ReqNum()
+            block.add_usage(node)
+            i = info["node_index"].get(id(block.req_node))
+            if i is None:
+                return self.skip(tape, "unknown requirement node")
+            usage[i] = usage.get(i, Tape.ReqNum()) + node.num
+
+        children = []
+        for i in new_tapes:
+            child = program.tapes[i]
+            if not child.purged:
+                return self.skip(tape, "unfinished tape %s" % child.name)
+            with open(child.outfile, "rb") as f:
+                child_code = f.read()
+            name, counter = child.name.rsplit("-", 1)
+            # the program name depends on the arguments
+            prefixed = name.startswith(program.name + "-")
+            if prefixed:
+                name = name[len(program.name) + 1:]
+            children.append(dict(
+                name=name, prefixed=prefixed,
+                counter=int(counter) - info["tape_counter"],
+                key=child.cache_key, code=child_code, size=len(child),
+                usage=dict(child.req_tree.aggregate()),
+                req_bit_length=dict(child.req_bit_length)))
+
+        entry = dict(
+            code=b"".join(code), size=len(tape),
+            usage=[(i, dict(num)) for i, num in sorted(usage.items())],
+            exported=[reg.i for reg in info["exported"]],
+            tapes=children,
+            tape_counter=program.tape_counter - info["tape_counter"],
+            req_bit_length=dict(tape.req_bit_length),
+            **effects
+        )
+
+        if not os.path.exists(self.dir):
+            os.mkdir(self.dir)
+        # write to a temporary file and rename to avoid partial entries
+        fd, tmp = tempfile.mkstemp(dir=self.dir)
+        try:
+            with os.fdopen(fd, "wb") as f:
+                pickle.dump(entry, f)
+            os.replace(tmp, self.dir + "/" + tape.cache_key)
+        except OSError:
+            os.remove(tmp)
+            raise
+        if program.verbose:
+            print("Cached optimization of tape", tape.name)
+
+    def skip(self, tape, reason):
+        if self.program.verbose:
+            print("Not caching tape %s because of %s" % (tape.name, reason))
+
+    def prune(self):
+        entries = [self.dir + "/" + x for x in os.listdir(self.dir)]
+        entries = [x for x in entries if os.path.isfile(x)]
+        entries.sort(key=os.path.getmtime)
+        for entry in entries[:-MAX_ENTRIES]:
+            try:
+                os.remove(entry)
+            except OSError:
+                pass
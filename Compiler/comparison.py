@@ -105,12 +105,69 @@ def LtzRing(a, k):
         u = CarryOutRaw(a[::-1], b[::-1])
         return sint.conv(r_bin[m].bit_xor(c_prime >> m).bit_xor(u))
 
+def SplitBitDecRaw(a, m):
+    """
+    Bit decomposition by local share conversion followed by a
+    carry-lookahead adder (logarithmic rounds)
+
+    m: number of bits to output
+    """
+    from .GC.types import sbitint
+    x = a.split_to_two_summands(m)
+    return sbitint.carry_lookahead_adder(x[0], x[1])[:m]
+
+def SplitEQZ(a, k):
+    """
+    Zero test by local share conversion without carry propagation:
+    x + y = 0 mod 2^k if and only if x_0 = y_0 and
+    x_i ^ y_i = x_{i-1} | y_{i-1} for 0 < i < k.
+
+    k: bit length of a
+    """
+    from .types import sintbit
+    x, y = a.split_to_two_summands(k)
+    diff = [util.bit_xor(x[0], y[0])]
+    for i in range(1, k):
+        prev = util.bit_xor(util.bit_xor(x[i - 1], y[i - 1]),
+                            util.bit_and(x[i - 1], y[i - 1]))
+        diff.append(util.bit_xor(util.bit_xor(x[i], y[i]), prev))
+    diff = [d for d in diff if not util.is_zero(d)]
+    if not diff:
+        return sintbit(1, size=a.size)
+    return sintbit.conv(util.tree_reduce(util.bit_and, (~d for d in diff)))
+
 def LessThanZero(a, k):
     from . import types
     res = types.sint()
     LTZ(res, a, k)
     return res
 
+@instructions_base.cisc
+def ArgMin(index, k, maximum, *columns):
+    """
+    index = position of the minimum (maximum if set) across columns
+
+    Tournament with one comparison and one selection per pair and
+    level. Ties go to the first minimum or the last maximum. Only the
+    emulator runs this natively, the compiler expands it for all
+    other protocols.
+
+    k: bit length of the inputs
+    """
+    entries = list(enumerate(columns))
+    assert len(entries) > 1
+    while len(entries) > 1:
+        next_entries = []
+        for (i, a), (j, b) in zip(entries[0::2], entries[1::2]):
+            c = LessThanZero(b - a, k + 1)
+            d, e = c * (b - a), c * (j - i)
+            if maximum:
+                next_entries.append((j - e, b - d))
+            else:
+                next_entries.append((i + e, a + d))
+        entries = next_entries + entries[len(entries) // 2 * 2:]
+    movs(index, entries[0][0])
+
 @instructions_base.cisc
 def Trunc(d, a, k, m, signed):
     """
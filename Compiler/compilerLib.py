@@ -222,6 +222,13 @@ class Compiler:
             help="speedup inverse permutation (only use in two-party, "
             "semi-honest environment)"
         )
+        parser.add_option(
+            "--cache",
+            action="store_true",
+            dest="cache",
+            help="reuse the optimization of tapes that are unchanged since "
+            "an earlier compilation (stored in Programs/Cache)",
+        )
         parser.add_option(
             "-C",
             "--CISC",
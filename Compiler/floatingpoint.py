@@ -54,10 +54,7 @@ def maskField(a, k):
 def EQZ(a, k):
     prog = program.Program.prog
     if prog.use_split():
-        from Compiler.GC.types import sbitvec
-        v = sbitvec(a, k).v
-        bit = util.tree_reduce(operator.and_, (~b for b in v))
-        return types.sintbit.conv(bit)
+        return comparison.SplitEQZ(a, k)
     return prog.non_linear.eqz(a, k)
 
 def bits(a,m):
@@ -303,9 +300,7 @@ def BitDecRingRaw(a, k, m):
     comparison.require_ring_size(m, 'bit decomposition')
     n_shift = int(program.Program.prog.options.ring) - m
     if program.Program.prog.use_split():
-        x = a.split_to_two_summands(m)
-        bits = types._bitint.bit_adder(x[0], x[1])
-        return bits[:m]
+        return comparison.SplitBitDecRaw(a, m)
     else:
         if program.Program.prog.use_edabit():
             r, r_bits = types.sint.get_edabit(m, strict=False)
@@ -488,6 +488,30 @@ class join_tape(base.Instruction):
     code = base.opcodes['JOIN_TAPE']
     arg_format = ['int']
 
+class initchunks(base.DoNotEliminateInstruction):
+    """ Initialize the distribution of chunks of a loop among threads
+    at runtime. See :py:func:`~Compiler.library.dynamic_multithread`.
+
+    :param: number of chunks (regint)
+    :param: number of threads (regint)
+    :param: pool identifier (int)
+    """
+    code = base.opcodes['INITCHUNKS']
+    arg_format = ['ci','ci','int']
+
+class nextchunk(base.DoNotEliminateInstruction):
+    """ Get next chunk for this thread or -1 if all chunks are
+    taken. Threads without own chunks left take over half of the
+    largest remainder of another thread. The first party decides and
+    informs the others.
+
+    :param: destination (regint)
+    :param: thread index (regint)
+    :param: pool identifier (int)
+    """
+    code = base.opcodes['NEXTCHUNK']
+    arg_format = ['ciw','ci','int']
+
 class call_tape(base.DoNotEliminateInstruction):
     """ Start tape/bytecode file in same thread. Arguments/return values
     starting from :py:obj:`direction` are optional.
@@ -2024,6 +2048,42 @@ class readsharesfromfile(base.VectorInstruction, base.IOInstruction):
     def has_var_args(self):
         return True
 
+class writesharestotable(base.VectorInstruction, base.IOInstruction):
+    """ Write shares to table in ``Persistence/<name>-P<playerno>.table``.
+
+    :param: number of arguments to follow / number of shares plus two (int)
+    :param: table name (16 bytes / 4 units, cut off at first zero byte)
+    :param: position (regint, -1 for appending)
+    :param: source (sint)
+    :param: (repeat from source)...
+
+    """
+    __slots__ = []
+    code = base.opcodes['WRITETABLESHARE']
+    arg_format = tools.chain(['str', 'ci'], itertools.repeat('s'))
+    vector_index = 2
+
+    def has_var_args(self):
+        return True
+
+class readsharesfromtable(base.VectorInstruction, base.IOInstruction):
+    """ Read shares from table in ``Persistence/<name>-P<playerno>.table``.
+
+    :param: number of arguments to follow / number of shares plus three (int)
+    :param: table name (16 bytes / 4 units, cut off at first zero byte)
+    :param: starting position in number of shares from beginning (regint)
+    :param: destination for final position, -1 for end of table reached, or -2 for table not found (regint)
+    :param: destination for share (sint)
+    :param: (repeat from destination for share)...
+    """
+    __slots__ = []
+    code = base.opcodes['READTABLESHARE']
+    arg_format = tools.chain(['str', 'ci', 'ciw'], itertools.repeat('sw'))
+    vector_index = 3
+
+    def has_var_args(self):
+        return True
+
 @base.gf2n
 @base.vectorize
 class raw_output(base.PublicFileIOInstruction):
@@ -2901,6 +2961,19 @@ class cisc:
       :param: fixed-point precision
       :param: (repeat)...
 
+    ArgMin
+      Position of minimum or maximum across several vectors. Only
+      implemented by the emulator.
+
+      :param: number of arguments in this unit (must be at least 7)
+      :param: vector size
+      :param: result (sint)
+      :param: bit length
+      :param: 0 for minimum (first if several) or 1 for maximum
+        (last if several)
+      :param: inputs (sint)
+      :param: (repeat)...
+
     """
     code = base.opcodes['CISC']
 
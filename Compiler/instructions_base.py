@@ -70,6 +70,8 @@ opcodes = dict(
     CMDLINEARG = 0xEB,
     CALL_TAPE = 0xEC,
     CALL_ARG = 0xED,
+    INITCHUNKS = 0xEE,
+    NEXTCHUNK = 0xEF,
     # Addition
     ADDC = 0x20,
     ADDS = 0x21,
@@ -212,6 +214,8 @@ opcodes = dict(
     PRINTFLOATPLAIN = 0xBC,
     WRITEFILESHARE = 0xBD,     
     READFILESHARE = 0xBE,
+    WRITETABLESHARE = 0xC2,
+    READTABLESHARE = 0xC3,
     CONDPRINTSTR = 0xBF,
     PRINTFLOATPREC = 0xE0,
     CONDPRINTPLAIN = 0xE1,
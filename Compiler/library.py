@@ -1271,6 +1271,96 @@ def multithread(n_threads, n_items=None, max_size=None):
                     function(base + size - rem, rem)
         return wrapper
 
+def dynamic_multithread(n_threads, n_items, chunk_size=1):
+    """
+    Distribute the computation of :py:obj:`n_items` in chunks of
+    :py:obj:`chunk_size` to :py:obj:`n_threads` threads at
+    runtime. Every thread starts with a contiguous share of the
+    chunks, and threads that run out take over chunks from others. This
+    balances the load if the cost per item varies. The first party
+    hands out up to half of a thread's remaining chunks at once,
+    which costs one message to the others. With malicious security,
+    the parties compare the schedules when a thread is done.
+
+    :param n_threads: compile-time (int)
+    :param n_items: regint/cint/int
+    :param chunk_size: compile-time (int)
+
+    The following executes ``f(0, 10)``, ``f(10, 10)``, ...,
+    ``f(990, 10)`` in four threads:
+
+    .. code::
+
+        @dynamic_multithread(4, 1000, 10)
+        def f(base, size):
+            ...
+    """
+    n_items = MemValue.if_necessary(n_items)
+    if util.is_constant(n_items) and n_items % chunk_size == 0:
+        n_chunks = n_items // chunk_size
+    else:
+        n_chunks = (n_items + chunk_size - 1) // chunk_size
+    def decorator(function):
+        prog = get_program()
+        pool = prog.n_chunk_pools
+        prog.n_chunk_pools += 1
+        initchunks(regint.conv(n_chunks), regint(n_threads), pool)
+        prevent_breaks = prog.prevent_breaks
+        def f():
+            prog.prevent_breaks = prevent_breaks
+            owner = get_arg()
+            @do_while
+            def _():
+                chunk = regint()
+                nextchunk(chunk, owner, pool)
+                @if_(chunk >= 0)
+                def _():
+                    base = chunk * chunk_size
+                    if util.is_constant(n_items) and \
+                       n_items % chunk_size == 0:
+                        size = chunk_size
+                    else:
+                        left = n_items - base
+                        size = (left < chunk_size).if_else(left, chunk_size)
+                    function(base, size)
+                return chunk >= 0
+        if prog.curr_tape.singular:
+            prog.n_running_threads = n_threads
+        prog.prevent_breaks = False
+        tape = prog.new_tape(f, name='dynamic_multithread')
+        prog.n_running_threads = None
+        threads = prog.run_tapes([(tape, i) for i in range(n_threads)])
+        prog.join_tapes(threads)
+        prog.free_later()
+        prog.prevent_breaks = prevent_breaks
+    return decorator
+
+def for_range_dynamic_multithread(n_threads, n_loops, chunk_size=1):
+    """
+    Execute :py:obj:`n_loops` loop bodies in :py:obj:`n_threads`
+    threads with the distribution decided at runtime as in
+    :py:func:`dynamic_multithread`. Use this instead of
+    :py:func:`for_range_multithread` if the cost per iteration is
+    uneven.
+
+    :param n_threads: compile-time (int)
+    :param n_loops: regint/cint/int
+    :param chunk_size: compile-time (int)
+
+    .. code::
+
+        @for_range_dynamic_multithread(4, n_clusters)
+        def _(i):
+            ...
+    """
+    def decorator(loop_body):
+        @dynamic_multithread(n_threads, n_loops, chunk_size)
+        def _(base, size):
+            @for_range(size)
+            def _(i):
+                loop_body(base + i)
+    return decorator
+
 def map_reduce(n_threads, n_parallel, n_loops, initializer, reducer, \
                    thread_mem_req={}, looping=True, budget=None):
     assert(n_threads != 0)
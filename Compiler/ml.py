@@ -61,7 +61,7 @@ an example of how to run MP-SPDZ on TensorFlow graphs.
 import math
 import re
 
-from Compiler import mpc_math, util
+from Compiler import mpc_math, util, comparison
 from Compiler.types import *
 from Compiler.types import _unreduced_squant
 from Compiler.library import *
@@ -149,16 +149,61 @@ def relu(x):
     """ ReLU function (maximum of input and zero). """
     return (0 < x).if_else(x, 0)
 
+def _argm(columns, maximum):
+    columns = list(columns)
+    if len(columns) == 1:
+        return 0
+    t = type(columns[0])
+    if t in (sint, sfix) and \
+       all(type(x) == t and x.size == columns[0].size for x in columns):
+        if t == sfix:
+            k = columns[0].k
+            columns = [x.v for x in columns]
+        else:
+            k = program.bit_length
+        res = sint(size=columns[0].size)
+        comparison.ArgMin(res, k, int(maximum), *columns)
+        return res
+    def op(a, b):
+        if maximum:
+            comp = (a[1] > b[1])
+        else:
+            comp = (a[1] <= b[1])
+        return comp.if_else(a[0], b[0]), comp.if_else(a[1], b[1])
+    return tree_reduce(op, enumerate(columns))[0]
+
 def argmax(x):
     """ Compute index of maximum element.
 
     :param x: iterable
     :returns: sint or 0 if :py:obj:`x` has length 1
     """
-    def op(a, b):
-        comp = (a[1] > b[1])
-        return comp.if_else(a[0], b[0]), comp.if_else(a[1], b[1])
-    return tree_reduce(op, enumerate(x))[0]
+    return _argm(x, True)
+
+def argmin(x):
+    """ Compute index of minimum element.
+
+    :param x: iterable
+    :returns: sint or 0 if :py:obj:`x` has length 1
+    """
+    return _argm(x, False)
+
+def argmax_rows(X):
+    """ Compute index of maximum element for every row at once.
+
+    :param X: matrix of :py:class:`sint` or :py:class:`sfix`
+    :returns: sint vector
+    """
+    return _argm((X.get_column(i) for i in range(X.sizes[1])), True)
+
+def argmin_rows(X):
+    """ Compute index of minimum element for every row at once,
+    for example the closest centroid in k-means.
+
+    :param X: matrix of :py:class:`sint` or :py:class:`sfix`
+    :returns: sint vector
+    """
+    return _argm((X.get_column(i) for i in range(X.sizes[1])), False)
 
 def softmax(x):
     """ Softmax.
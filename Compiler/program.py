@@ -69,6 +69,7 @@ class defaults:
     stop = False
     insecure = False
     keep_cisc = False
+    cache = False
 
 
 class Program(object):
@@ -219,6 +220,7 @@ class Program(object):
         self.warn_about_mem = [True]
         self.relevant_opts = set()
         self.n_running_threads = None
+        self.n_chunk_pools = 0
         self.input_files = {}
         self.base_addresses = util.dict_by_id()
         self._protect_memory = False
@@ -232,6 +234,11 @@ class Program(object):
         self.use_tape_calls = True
         self.force_cisc_tape = False
         self.have_warned_trunc_pr = False
+        self.tape_cache = None
+        if options.cache and not (options.debug or options.asmoutfile):
+            from .cache import TapeCache
+
+            self.tape_cache = TapeCache(self)
 
         Program.prog = self
         from . import comparison, instructions, instructions_base, types
@@ -859,6 +866,7 @@ class Tape:
         self.warned_about_mem = False
         self.return_values = []
         self.ran_threads = False
+        self.cache_key = None
         self.unused_decorators = {}
 
     class BasicBlock(object):
@@ -953,7 +961,7 @@ class Tape:
 
         def expand_cisc(self):
             if self.parent.program.options.keep_cisc is not None:
-                skip = ["LTZ", "Trunc", "EQZ"]
+                skip = ["LTZ", "Trunc", "EQZ", "ArgMin"]
                 skip += self.parent.program.options.keep_cisc.split(",")
             else:
                 skip = []
@@ -1064,6 +1072,81 @@ class Tape:
                 "Processing tape", self.name, "with %d blocks" % len(self.basicblocks)
             )
 
+        cache = self.program.tape_cache
+        if not (cache and cache.restore(self)):
+            self.optimize_blocks(options)
+            if cache:
+                cache.store(self)
+
+        # offline data requirements
+        if self.program.verbose:
+            print("Compile offline data requirements...")
+        for block in self.basicblocks:
+            block.req_node.add_block(block)
+        self.req_num = self.req_tree.aggregate()
+        if self.program.verbose:
+            print("Tape requires", self.req_num)
+        for req, num in sorted(self.req_num.items()):
+            if num == float("inf") or num >= 2**64:
+                num = -1
+            if req[1] in data_types:
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use(
+                        field_types[req[0]], data_types[req[1]], num, add_to_prog=False
+                    )
+                )
+            elif req[1] == "input":
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use_inp(
+                        field_types[req[0]], req[2], num, add_to_prog=False
+                    )
+                )
+            elif req[0] == "modp":
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use_prep(req[1], num, add_to_prog=False)
+                )
+            elif req[0] == "gf2n":
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.guse_prep(req[1], num, add_to_prog=False)
+                )
+            elif req[0] == "edabit":
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use_edabit(
+                        False, req[1], num, add_to_prog=False
+                    )
+                )
+            elif req[0] == "sedabit":
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use_edabit(
+                        True, req[1], num, add_to_prog=False
+                    )
+                )
+            elif req[0] == "matmul":
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use_matmul(*req[1], num, add_to_prog=False)
+                )
+
+        if not self.is_empty():
+            # bit length requirement
+            for x in ("p", "2"):
+                if self.req_bit_length[x]:
+                    bl = self.req_bit_length[x]
+                    if self.program.options.ring:
+                        bl = -int(self.program.options.ring)
+                    self.basicblocks[-1].instructions.append(
+                        Compiler.instructions.reqbl(bl, add_to_prog=False)
+                    )
+            if self.program.verbose:
+                print("Tape requires prime bit length",
+                      self.req_bit_length["p"],
+                      ('for %s' % self.bit_length_reason
+                       if self.bit_length_reason else ''))
+                print("Tape requires galois bit length", self.req_bit_length["2"])
+
+    @unpurged
+    def optimize_blocks(self, options):
+        """Merge instructions, expand CISC instructions, and allocate
+        registers."""
         for block in self.basicblocks:
             al.determine_scope(block, options)
 
@@ -1217,71 +1300,6 @@ class Tape:
                 n_fragments = sum(scope.n_fragments() for scope in scopes)
                 print("%d register fragments in %d scopes" % (n_fragments, len(scopes)))
 
-        # offline data requirements
-        if self.program.verbose:
-            print("Compile offline data requirements...")
-        for block in self.basicblocks:
-            block.req_node.add_block(block)
-        self.req_num = self.req_tree.aggregate()
-        if self.program.verbose:
-            print("Tape requires", self.req_num)
-        for req, num in sorted(self.req_num.items()):
-            if num == float("inf") or num >= 2**64:
-                num = -1
-            if req[1] in data_types:
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.use(
-                        field_types[req[0]], data_types[req[1]], num, add_to_prog=False
-                    )
-                )
-            elif req[1] == "input":
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.use_inp(
-                        field_types[req[0]], req[2], num, add_to_prog=False
-                    )
-                )
-            elif req[0] == "modp":
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.use_prep(req[1], num, add_to_prog=False)
-                )
-            elif req[0] == "gf2n":
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.guse_prep(req[1], num, add_to_prog=False)
-                )
-            elif req[0] == "edabit":
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.use_edabit(
-                        False, req[1], num, add_to_prog=False
-                    )
-                )
-            elif req[0] == "sedabit":
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.use_edabit(
-                        True, req[1], num, add_to_prog=False
-                    )
-                )
-            elif req[0] == "matmul":
-                self.basicblocks[-1].instructions.append(
-                    Compiler.instructions.use_matmul(*req[1], num, add_to_prog=False)
-                )
-
-        if not self.is_empty():
-            # bit length requirement
-            for x in ("p", "2"):
-                if self.req_bit_length[x]:
-                    bl = self.req_bit_length[x]
-                    if self.program.options.ring:
-                        bl = -int(self.program.options.ring)
-                    self.basicblocks[-1].instructions.append(
-                        Compiler.instructions.reqbl(bl, add_to_prog=False)
-                    )
-            if self.program.verbose:
-                print("Tape requires prime bit length",
-                      self.req_bit_length["p"],
-                      ('for %s' % self.bit_length_reason
-                       if self.bit_length_reason else ''))
-                print("Tape requires galois bit length", self.req_bit_length["2"])
-
     @unpurged
     def expand_cisc(self):
         mapping = {None: None}
@@ -1362,6 +1380,33 @@ class Tape:
                 h.update(b)
         f.close()
         self.hash = h.digest()
+        loc_filename = filename[:-3] + ".loc"
+        if self.program.DEBUG:
+            self.write_locations(loc_filename)
+        elif os.path.exists(loc_filename):
+            os.remove(loc_filename)
+
+    @unpurged
+    def write_locations(self, filename):
+        """Write basic block and user source lines per instruction
+        for the profiler in the virtual machine."""
+        compiler_dir = os.path.dirname(os.path.abspath(__file__))
+        excluded = (compiler_dir, os.path.dirname(os.__file__),
+                    os.path.join(os.path.dirname(compiler_dir), "compile.py"))
+        f = open(filename, "w")
+        for block in self.basicblocks:
+            for i in block.instructions:
+                if i is None:
+                    continue
+                frames = [block.name]
+                for frame in reversed(i.caller or []):
+                    path = os.path.abspath(frame[0])
+                    if not path.startswith(excluded) and \
+                       not frame[0].startswith("<"):
+                        frames.append("%s:%d" % (os.path.basename(path),
+                                                 frame[1]))
+                f.write(";".join(x.replace(";", ",") for x in frames) + "\n")
+        f.close()
 
     def new_reg(self, reg_type, size=None):
         return self.Register(reg_type, self, size=size)
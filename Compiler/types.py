@@ -2693,7 +2693,8 @@ class sint(_secret, _int):
         writesocketshare(client_id, message_type, values[0].size, *values)
 
     @classmethod
-    def read_from_file(cls, start, n_items=1, crash_if_missing=True, size=1):
+    def read_from_file(cls, start, n_items=1, crash_if_missing=True, size=1,
+                       table=None):
         """ Read shares from
         ``Persistence/Transactions-P<playerno>.data``. See :ref:`this
         section <persistence>` for details on the data format.
@@ -2702,18 +2703,24 @@ class sint(_secret, _int):
         :param n_items: number of items (int)
         :param crash_if_missing: crash if file not found (default)
         :param size: vector size (int)
+        :param table: read from named table in
+            ``Persistence/<table>-P<playerno>.table`` instead (str of
+            at most 16 characters)
         :returns: destination for final position, -1 for eof reached, or -2 for file not found (regint)
         :returns: list of shares
         """
         shares = [cls(size=size) for i in range(n_items)]
         stop = regint()
-        readsharesfromfile(regint.conv(start), stop, *shares)
+        if table is None:
+            readsharesfromfile(regint.conv(start), stop, *shares)
+        else:
+            readsharesfromtable(table, regint.conv(start), stop, *shares)
         if crash_if_missing:
             library.runtime_error_if(stop == -2, 'Persistence not found')
         return stop, shares
 
     @staticmethod
-    def write_to_file(shares, position=None):
+    def write_to_file(shares, position=None, table=None):
         """ Write shares to ``Persistence/Transactions-P<playerno>.data``
         (appending at the end). See :ref:`this section <persistence>`
         for details on the data format.
@@ -2721,6 +2728,9 @@ class sint(_secret, _int):
         :param shares: (list or iterable of sint)
         :param position: start position (int/regint/cint),
             defaults to end of file
+        :param table: write to named table in
+            ``Persistence/<table>-P<playerno>.table`` instead (str of
+            at most 16 characters)
         """
         if isinstance(shares, sint):
             shares = [shares]
@@ -2729,7 +2739,10 @@ class sint(_secret, _int):
             assert share.size == shares[0].size
         if position is None:
             position = -1
-        writesharestofile(regint.conv(position), *shares)
+        if table is None:
+            writesharestofile(regint.conv(position), *shares)
+        else:
+            writesharestotable(table, regint.conv(position), *shares)
 
     @vectorized_classmethod
     def load_mem(cls, address, mem_type=None):
@@ -4481,7 +4494,7 @@ class _single(_number, _secret_structure):
         return stop, [cls._new(x) for x in shares]
 
     @classmethod
-    def write_to_file(cls, shares, position=None):
+    def write_to_file(cls, shares, position=None, table=None):
         """ Write shares of integer representation to
         ``Persistence/Transactions-P<playerno>.data``. See :ref:`this
         section <persistence>` for details on the data format.
@@ -4489,8 +4502,9 @@ class _single(_number, _secret_structure):
         :param shares: (list or iterable of sfix)
         :param position: start position (int/regint/cint),
             defaults to end of file
+        :param table: use named table instead (str)
         """
-        cls.int_type.write_to_file([x.v for x in shares], position)
+        cls.int_type.write_to_file([x.v for x in shares], position, table)
 
     def store_in_mem(self, address):
         """ Store in memory by public address. """
@@ -6230,20 +6244,21 @@ class Array(_vectorizable):
             res.write(stop)
         return res
 
-    def write_to_file(self, position=None):
+    def write_to_file(self, position=None, table=None):
         """ Write shares of integer representation to
         ``Persistence/Transactions-P<playerno>.data``. See :ref:`this
         section <persistence>` for details on the data format.
 
         :param position: start position (int/regint/cint),
             defaults to end of file
+        :param table: use named table instead (str)
         """
         if position is not None:
             position = regint(position)
         @library.multithread(None, len(self), max_size=program.budget)
         def _(base, size):
             self.value_type.write_to_file(self.get_vector(base=base, size=size),
-                                          position)
+                                          position, table)
             if position is not None:
                 position.iadd(size)
 
@@ -6779,13 +6794,14 @@ class SubMultiArray(_vectorizable):
             def _(i):
                 self[i].input_from(player, budget=budget, raw=raw, **kwargs)
 
-    def write_to_file(self, position=None):
+    def write_to_file(self, position=None, table=None):
         """ Write shares of integer representation to
         ``Persistence/Transactions-P<playerno>.data``. See :ref:`this
         section <persistence>` for details on the data format.
 
         :param position: start position (int/regint/cint),
             defaults to end of file
+        :param table: use named table instead (str)
         """
         @library.for_range(len(self))
         def _(i):
@@ -6793,7 +6809,7 @@ class SubMultiArray(_vectorizable):
                 my_pos = None
             else:
                 my_pos = position + i * self[i].total_size()
-            self[i].write_to_file(my_pos)
+            self[i].write_to_file(my_pos, table)
 
     def read_from_file(self, start, *args, **kwargs):
         """ Read content from ``Persistence/Transactions-P<playerno>.data``.
@@ -16,6 +16,11 @@ public:
     bool check_open;
     bool check_beaver_open;
     bool R_after_msg;
+    int service_port;
+    int load_rate;
+    int load_requests;
+    int max_batch;
+    int service_timeout;
 
     EcdsaOptions(ez::ezOptionParser& opt, int argc, const char** argv)
     {
@@ -64,14 +69,72 @@ public:
                 "-R", // Flag token.
                 "--R-after-msg" // Flag token.
         );
+        opt.add(
+                "", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Keep signing requests from external clients on this port base", // Help description.
+                "-ss", // Flag token.
+                "--sign-service" // Flag token.
+        );
+        opt.add(
+                "0", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Keep signing generated requests at this rate per second", // Help description.
+                "-lt", // Flag token.
+                "--load-test" // Flag token.
+        );
+        opt.add(
+                "10000", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Number of generated requests (default: 10000)", // Help description.
+                "-lr", // Flag token.
+                "--load-requests" // Flag token.
+        );
+        opt.add(
+                "100", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Maximum number of signatures sharing a round (default: 100)", // Help description.
+                "-mb", // Flag token.
+                "--max-batch" // Flag token.
+        );
+        opt.add(
+                "60", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Stop the signing service after this many seconds without "
+                "requests, 0 for never (default: 60)", // Help description.
+                "-st", // Flag token.
+                "--service-timeout" // Flag token.
+        );
         opt.parse(argc, argv);
         prep_mul = not opt.isSet("-D");
         fewer_rounds = opt.isSet("-P");
         check_open = not opt.isSet("-C");
         check_beaver_open = not opt.isSet("-B");
         R_after_msg = opt.isSet("-R");
+        service_port = -1;
+        if (opt.isSet("-ss"))
+            opt.get("-ss")->getInt(service_port);
+        opt.get("-lt")->getInt(load_rate);
+        opt.get("-lr")->getInt(load_requests);
+        opt.get("-mb")->getInt(max_batch);
+        opt.get("-st")->getInt(service_timeout);
         opt.resetArgs();
     }
+
+    bool service() const
+    {
+        return service_port >= 0 or load_rate > 0;
+    }
 };
 
 #endif /* ECDSA_ECDSAOPTIONS_H_ */
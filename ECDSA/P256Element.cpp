@@ -7,144 +7,387 @@
 
 #include "Math/gfp.hpp"
 
-EC_GROUP* P256Element::curve;
+const uint64_t Secp256k1Field::P[4] = { 0xfffffffefffffc2f,
+        0xffffffffffffffff, 0xffffffffffffffff, 0xffffffffffffffff };
+
+P256Element::Affine P256Element::fixed_base[N_WINDOWS][16];
 
 void P256Element::init()
 {
-    curve = EC_GROUP_new_by_curve_name(NID_secp256k1);
-    assert(curve != 0);
-    auto modulus = EC_GROUP_get0_order(curve);
-    auto mod = BN_bn2dec(modulus);
-    Scalar::init_field(mod, false);
-    free(mod);
+    Scalar::init_field(
+            "115792089237316195423570985008687907852837564279074904382605163141518161494337",
+            false);
+
+    const uint64_t gx[] = { 0x59f2815b16f81798, 0x029bfcdb2dce28d9,
+            0x55a06295ce870b07, 0x79be667ef9dcbbac };
+    const uint64_t gy[] = { 0x9c47d08ffb10d4b8, 0xfd17b448a6855419,
+            0x5da4fbfc0e1108a8, 0x483ada7726a3c465 };
+    P256Element base;
+    base.X = gx;
+    base.Y = gy;
+    base.Z = 1;
+    base.check();
+
+    // compute all entries at once and convert with one inversion
+    vector<P256Element> multiples;
+    for (int i = 0; i < N_WINDOWS; i++)
+    {
+        P256Element multiple;
+        for (int j = 0; j < 16; j++)
+        {
+            multiples.push_back(multiple);
+            multiple.add(base);
+        }
+        base = multiple;
+    }
+    batch_normalize(multiples);
+    for (int i = 0; i < N_WINDOWS; i++)
+        for (int j = 1; j < 16; j++)
+            fixed_base[i][j] = multiples[16 * i + j].to_affine();
 }
 
 void P256Element::finish()
 {
-    EC_GROUP_free(curve);
 }
 
-P256Element::P256Element()
+P256Element::P256Element() :
+        X(1), Y(1), Z()
 {
-    point = EC_POINT_new(curve);
-    assert(point != 0);
-    assert(EC_POINT_set_to_infinity(curve, point) != 0);
 }
 
 P256Element::P256Element(const Scalar& other) :
         P256Element()
 {
-    BIGNUM* exp = BN_new();
-    BN_dec2bn(&exp, bigint(other).get_str().c_str());
-    assert(EC_POINT_mul(curve, point, exp, 0, 0, 0) != 0);
-    BN_free(exp);
+    unsigned char digits[N_WINDOWS];
+    get_digits(digits, other);
+    for (int i = 0; i < N_WINDOWS; i++)
+        add(lookup(fixed_base[i], digits[i]), digits[i] == 0);
 }
 
 P256Element::P256Element(word other) :
-        P256Element()
+        P256Element(Scalar(bigint(other)))
 {
-    BIGNUM* exp = BN_new();
-    BN_dec2bn(&exp, to_string(other).c_str());
-    assert(EC_POINT_mul(curve, point, exp, 0, 0, 0) != 0);
-    BN_free(exp);
 }
 
-P256Element::~P256Element()
+void P256Element::get_digits(unsigned char* digits, const Scalar& scalar)
 {
-    EC_POINT_free(point);
+    auto& tmp = bigint::tmp;
+    to_bigint(tmp, scalar);
+    for (int i = 0; i < 4; i++)
+    {
+        uint64_t limb = mpz_getlimbn(tmp.get_mpz_t(), i);
+        for (int j = 0; j < 16; j++)
+            digits[16 * i + j] = (limb >> (4 * j)) & 0xF;
+    }
 }
 
-P256Element& P256Element::operator =(const P256Element& other)
+P256Element::Affine P256Element::lookup(const Affine* table, int digit)
 {
-    assert(EC_POINT_copy(point, other.point) != 0);
-    return *this;
+    Affine res;
+    for (int j = 1; j < 16; j++)
+    {
+        res.x = Field::select(res.x, table[j].x, j == digit);
+        res.y = Field::select(res.y, table[j].y, j == digit);
+    }
+    return res;
+}
+
+P256Element P256Element::lookup(const P256Element* table, int digit)
+{
+    P256Element res;
+    for (int j = 1; j < 16; j++)
+        res.select(table[j], j == digit);
+    return res;
+}
+
+void P256Element::select(const P256Element& other, bool choose_other)
+{
+    X = Field::select(X, other.X, choose_other);
+    Y = Field::select(Y, other.Y, choose_other);
+    Z = Field::select(Z, other.Z, choose_other);
+}
+
+P256Element P256Element::dbl() const
+{
+    // dbl-2009-l, keeps Z = 0
+    P256Element res;
+    Field A = X.sqr();
+    Field B = Y.sqr();
+    Field C = B.sqr();
+    Field D = ((X + B).sqr() - A - C) * 2;
+    Field E = A * 3;
+    res.X = E.sqr() - D * 2;
+    res.Y = E * (D - res.X) - C * 8;
+    res.Z = Y * Z * 2;
+    return res;
+}
+
+void P256Element::add(const Affine& other, bool skip)
+{
+    // madd-2007-bl
+    bool infinity = is_infinity();
+    Field Z1Z1 = Z.sqr();
+    Field U2 = other.x * Z1Z1;
+    Field S2 = other.y * Z * Z1Z1;
+    Field H = U2 - X;
+    Field r = (S2 - Y) * 2;
+
+    // same x coordinate, only happens with negligible probability
+    // for random scalars
+    if (H.is_zero() and not infinity and not skip)
+    {
+        if (r.is_zero())
+            *this = dbl();
+        else
+            *this = {};
+        return;
+    }
+
+    P256Element res;
+    Field HH = H.sqr();
+    Field I = HH * 4;
+    Field J = H * I;
+    Field V = X * I;
+    res.X = r.sqr() - J - V * 2;
+    res.Y = r * (V - res.X) - Y * J * 2;
+    res.Z = (Z + H).sqr() - Z1Z1 - HH;
+
+    P256Element lifted;
+    lifted.X = other.x;
+    lifted.Y = other.y;
+    lifted.Z = 1;
+    res.select(lifted, infinity);
+    select(res, not skip);
+}
+
+void P256Element::add(const P256Element& other, bool skip)
+{
+    // add-2007-bl
+    bool infinity = is_infinity();
+    bool other_infinity = other.is_infinity();
+    Field Z1Z1 = Z.sqr();
+    Field Z2Z2 = other.Z.sqr();
+    Field U1 = X * Z2Z2;
+    Field U2 = other.X * Z1Z1;
+    Field S1 = Y * other.Z * Z2Z2;
+    Field S2 = other.Y * Z * Z1Z1;
+    Field H = U2 - U1;
+    Field r = (S2 - S1) * 2;
+
+    if (H.is_zero() and not infinity and not other_infinity and not skip)
+    {
+        if (r.is_zero())
+            *this = dbl();
+        else
+            *this = {};
+        return;
+    }
+
+    P256Element res;
+    Field I = (H * 2).sqr();
+    Field J = H * I;
+    Field V = U1 * I;
+    res.X = r.sqr() - J - V * 2;
+    res.Y = r * (V - res.X) - S1 * J * 2;
+    res.Z = ((Z + other.Z).sqr() - Z1Z1 - Z2Z2) * H;
+
+    res.select(other, infinity);
+    res.select(*this, other_infinity);
+    select(res, not skip);
+}
+
+P256Element::Affine P256Element::to_affine() const
+{
+    assert(not is_infinity());
+    Affine res;
+    if (Z == 1)
+    {
+        res.x = X;
+        res.y = Y;
+    }
+    else
+    {
+        Field inv = Z.invert();
+        Field inv2 = inv.sqr();
+        res.x = X * inv2;
+        res.y = Y * inv2 * inv;
+    }
+    return res;
+}
+
+void P256Element::batch_normalize(vector<P256Element>& points)
+{
+    // Montgomery's trick
+    vector<Field> prefix;
+    Field acc = 1;
+    for (auto& point : points)
+    {
+        prefix.push_back(acc);
+        if (not point.is_infinity())
+            acc *= point.Z;
+    }
+    Field inv = acc.invert();
+    for (size_t i = points.size(); i-- > 0;)
+    {
+        auto& point = points[i];
+        if (point.is_infinity())
+            continue;
+        Field z_inv = inv * prefix[i];
+        inv *= point.Z;
+        Field z_inv2 = z_inv.sqr();
+        point.X *= z_inv2;
+        point.Y *= z_inv2 * z_inv;
+        point.Z = 1;
+    }
+}
+
+P256Element P256Element::multi_mul(const vector<P256Element>& points,
+        const vector<Scalar>& scalars)
+{
+    // Straus with a shared doubling chain
+    assert(points.size() == scalars.size());
+    size_t n = points.size();
+    vector<array<P256Element, 16>> tables(n);
+    vector<array<unsigned char, N_WINDOWS>> digits(n);
+    for (size_t k = 0; k < n; k++)
+    {
+        auto& table = tables[k];
+        for (int j = 1; j < 16; j++)
+        {
+            table[j] = table[j - 1];
+            table[j].add(points[k]);
+        }
+        get_digits(digits[k].data(), scalars[k]);
+    }
+
+    P256Element res;
+    for (int i = N_WINDOWS - 1; i >= 0; i--)
+    {
+        for (int j = 0; j < 4; j++)
+            res = res.dbl();
+        for (size_t k = 0; k < n; k++)
+            res.add(lookup(tables[k].data(), digits[k][i]),
+                    digits[k][i] == 0);
+    }
+    return res;
 }
 
 void P256Element::check()
 {
-    assert(EC_POINT_is_on_curve(curve, point, 0) == 1);
+    Field Z2 = Z.sqr();
+    Field Z6 = Z2.sqr() * Z2;
+    assert(Y.sqr() == X.sqr() * X + Z6 * 7);
 }
 
 P256Element::Scalar P256Element::x() const
 {
-    BIGNUM* x = BN_new();
-#if OPENSSL_VERSION_MAJOR >= 3
-    assert(EC_POINT_get_affine_coordinates(curve, point, x, 0, 0) != 0);
-#else
-    assert(EC_POINT_get_affine_coordinates_GFp(curve, point, x, 0, 0) != 0);
-#endif
-    char* xx = BN_bn2dec(x);
-    Scalar res((bigint(xx)));
-    OPENSSL_free(xx);
-    BN_free(x);
-    return res;
+    auto x = to_affine().x;
+    uint64_t limbs[4];
+    for (int i = 0; i < 4; i++)
+        limbs[i] = x.get_limb(i);
+    auto& tmp = bigint::tmp;
+    mpz_import(tmp.get_mpz_t(), 4, -1, sizeof(limbs[0]), 0, 0, limbs);
+    return tmp;
 }
 
 P256Element P256Element::operator +(const P256Element& other) const
 {
-    P256Element res;
-    assert(EC_POINT_add(curve, res.point, point, other.point, 0) != 0);
+    P256Element res = *this;
+    res.add(other);
     return res;
 }
 
 P256Element P256Element::operator -(const P256Element& other) const
 {
     P256Element tmp = other;
-    assert(EC_POINT_invert(curve, tmp.point, 0) != 0);
+    tmp.Y = -tmp.Y;
     return *this + tmp;
 }
 
 P256Element P256Element::operator *(const Scalar& other) const
 {
+    // fixed 4-bit window
+    P256Element table[16];
+    for (int j = 1; j < 16; j++)
+    {
+        table[j] = table[j - 1];
+        table[j].add(*this);
+    }
+
+    unsigned char digits[N_WINDOWS];
+    get_digits(digits, other);
     P256Element res;
-    BIGNUM* exp = BN_new();
-    BN_dec2bn(&exp, bigint(other).get_str().c_str());
-    assert(EC_POINT_mul(curve, res.point, 0, point, exp, 0) != 0);
-    BN_free(exp);
+    for (int i = N_WINDOWS - 1; i >= 0; i--)
+    {
+        for (int j = 0; j < 4; j++)
+            res = res.dbl();
+        res.add(lookup(table, digits[i]), digits[i] == 0);
+    }
     return res;
 }
 
 bool P256Element::operator ==(const P256Element& other) const
 {
-    int cmp = EC_POINT_cmp(curve, point, other.point, 0);
-    assert(cmp == 0 or cmp == 1);
-    return not cmp;
+    if (is_infinity() or other.is_infinity())
+        return is_infinity() and other.is_infinity();
+    Field Z1Z1 = Z.sqr();
+    Field Z2Z2 = other.Z.sqr();
+    return X * Z2Z2 == other.X * Z1Z1
+            and Y * Z2Z2 * other.Z == other.Y * Z1Z1 * Z;
 }
 
 void P256Element::pack(octetStream& os, int) const
 {
-    octet* buffer;
-    size_t length = EC_POINT_point2buf(curve, point,
-            POINT_CONVERSION_COMPRESSED, &buffer, 0);
-    assert(length != 0);
-    os.store_int(length, 8);
-    os.append(buffer, length);
-    free(buffer);
+    // compressed SEC1 encoding, single zero byte for infinity
+    if (is_infinity())
+    {
+        os.store_int(1, 8);
+        os.store_int(0, 1);
+        return;
+    }
+    auto affine = to_affine();
+    octet buffer[33];
+    buffer[0] = 2 + affine.y.is_odd();
+    affine.x.to_bytes(buffer + 1);
+    os.store_int(sizeof(buffer), 8);
+    os.append(buffer, sizeof(buffer));
 }
 
 void P256Element::unpack(octetStream& os, int)
 {
     size_t length = os.get_int(8);
-    assert(
-            EC_POINT_oct2point(curve, point, os.consume(length), length, 0)
-                    != 0);
+    octet* buffer = os.consume(length);
+    if (length == 1 and buffer[0] == 0)
+    {
+        *this = {};
+        return;
+    }
+    if (length != 33 or (buffer[0] & ~1) != 2)
+        throw runtime_error("invalid point encoding");
+    X = Field::from_bytes(buffer + 1);
+    Field rhs = X.sqr() * X + 7;
+    Y = rhs.sqrt();
+    if (Y.sqr() != rhs)
+        throw runtime_error("point not on curve");
+    if (Y.is_odd() != (buffer[0] & 1))
+        Y = -Y;
+    Z = 1;
 }
 
 ostream& operator <<(ostream& s, const P256Element& x)
 {
-    char* hex = EC_POINT_point2hex(x.curve, x.point,
-            POINT_CONVERSION_COMPRESSED, 0);
-    s << hex;
-    OPENSSL_free(hex);
+    octetStream os;
+    x.pack(os);
+    os.get_int(8);
+    char hex[3];
+    while (os.left())
+    {
+        snprintf(hex, sizeof(hex), "%02X", unsigned(os.get_int(1)));
+        s << hex;
+    }
     return s;
 }
 
-P256Element::P256Element(const P256Element& other) :
-        P256Element()
-{
-    *this = other;
-}
-
 P256Element operator*(const P256Element::Scalar& x, const P256Element& y)
 {
     return y * x;
@@ -152,7 +395,7 @@ P256Element operator*(const P256Element::Scalar& x, const P256Element& y)
 
 P256Element& P256Element::operator +=(const P256Element& other)
 {
-    *this = *this + other;
+    add(other);
     return *this;
 }
 
@@ -6,20 +6,49 @@
 #ifndef ECDSA_P256ELEMENT_H_
 #define ECDSA_P256ELEMENT_H_
 
-#include <openssl/ec.h>
-#include <openssl/obj_mac.h>
+#include "Secp256k1Field.h"
 
 #include "Math/gfp.h"
 
+/*
+ * Point on secp256k1 (despite the name) in Jacobian coordinates.
+ * Multiplications with the generator use precomputed tables.
+ * Scalar multiplications run the same sequence of operations
+ * for all scalars except with negligible probability.
+ */
 class P256Element : public ValueInterface
 {
 public:
     typedef gfp_<2, 4> Scalar;
+    typedef Secp256k1Field Field;
 
 private:
-    static EC_GROUP* curve;
+    class Affine
+    {
+    public:
+        Field x, y;
+    };
+
+    static const int N_WINDOWS = 64;
+
+    // j * 16^i * G
+    static Affine fixed_base[N_WINDOWS][16];
+
+    // Z = 0 for the point at infinity
+    Field X, Y, Z;
 
-    EC_POINT* point;
+    static void get_digits(unsigned char* digits, const Scalar& scalar);
+
+    static Affine lookup(const Affine* table, int digit);
+    static P256Element lookup(const P256Element* table, int digit);
+
+    P256Element dbl() const;
+    void add(const Affine& other, bool skip = false);
+    void add(const P256Element& other, bool skip = false);
+    void select(const P256Element& other, bool choose_other);
+
+    bool is_infinity() const { return Z.is_zero(); }
+    Affine to_affine() const;
 
 public:
     typedef P256Element next;
@@ -34,13 +63,13 @@ public:
     static void init();
     static void finish();
 
+    static void batch_normalize(vector<P256Element>& points);
+    static P256Element multi_mul(const vector<P256Element>& points,
+            const vector<Scalar>& scalars);
+
     P256Element();
-    P256Element(const P256Element& other);
     P256Element(const Scalar& other);
     P256Element(word other);
-    ~P256Element();
-
-    P256Element& operator=(const P256Element& other);
 
     void check();
 
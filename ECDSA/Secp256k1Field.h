@@ -0,0 +1,283 @@
+/*
+ * Secp256k1Field.h
+ *
+ */
+
+#ifndef ECDSA_SECP256K1FIELD_H_
+#define ECDSA_SECP256K1FIELD_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Element of the base field of secp256k1, p = 2^256 - 2^32 - 977.
+ * Four 64-bit limbs, always fully reduced.
+ * All operations run in time independent of the values.
+ */
+class Secp256k1Field
+{
+    typedef unsigned __int128 u128;
+
+    // 2^256 mod p
+    static const uint64_t C = 0x1000003D1;
+
+    uint64_t x[4];
+
+    static void select(uint64_t* res, const uint64_t* a, const uint64_t* b,
+            uint64_t mask)
+    {
+        for (int i = 0; i < 4; i++)
+            res[i] = (a[i] & ~mask) | (b[i] & mask);
+    }
+
+    // reduces a + carry * 2^256 for carry < 2^34
+    void reduce(uint64_t carry)
+    {
+        u128 t = u128(carry) * C;
+        for (int i = 0; i < 4; i++)
+        {
+            t += x[i];
+            x[i] = t;
+            t >>= 64;
+        }
+        // at most one more wrap-around
+        uint64_t wrap = -uint64_t(t);
+        t = C & wrap;
+        for (int i = 0; i < 4; i++)
+        {
+            t += x[i];
+            x[i] = t;
+            t >>= 64;
+        }
+        reduce_once();
+    }
+
+    // subtracts p if x >= p
+    void reduce_once()
+    {
+        uint64_t y[4];
+        u128 t = u128(x[0]) + C;
+        y[0] = t;
+        t >>= 64;
+        for (int i = 1; i < 4; i++)
+        {
+            t += x[i];
+            y[i] = t;
+            t >>= 64;
+        }
+        // x + C overflows iff x >= p
+        select(x, x, y, -uint64_t(t));
+    }
+
+public:
+    static const uint64_t P[4];
+
+    static Secp256k1Field from_bytes(const unsigned char* bytes)
+    {
+        Secp256k1Field res;
+        for (int i = 0; i < 4; i++)
+        {
+            res.x[3 - i] = 0;
+            for (int j = 0; j < 8; j++)
+                res.x[3 - i] = (res.x[3 - i] << 8) | bytes[8 * i + j];
+        }
+        res.reduce_once();
+        return res;
+    }
+
+    static Secp256k1Field select(const Secp256k1Field& a,
+            const Secp256k1Field& b, bool choose_b)
+    {
+        Secp256k1Field res;
+        select(res.x, a.x, b.x, -uint64_t(choose_b));
+        return res;
+    }
+
+    Secp256k1Field()
+    {
+        memset(x, 0, sizeof(x));
+    }
+
+    Secp256k1Field(uint64_t a)
+    {
+        memset(x, 0, sizeof(x));
+        x[0] = a;
+    }
+
+    Secp256k1Field(const uint64_t* limbs)
+    {
+        memcpy(x, limbs, sizeof(x));
+        reduce_once();
+    }
+
+    uint64_t get_limb(int i) const
+    {
+        return x[i];
+    }
+
+    void to_bytes(unsigned char* bytes) const
+    {
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 8; j++)
+                bytes[8 * i + j] = x[3 - i] >> (56 - 8 * j);
+    }
+
+    bool is_zero() const
+    {
+        return (x[0] | x[1] | x[2] | x[3]) == 0;
+    }
+
+    bool is_odd() const
+    {
+        return x[0] & 1;
+    }
+
+    bool operator==(const Secp256k1Field& other) const
+    {
+        return ((x[0] ^ other.x[0]) | (x[1] ^ other.x[1])
+                | (x[2] ^ other.x[2]) | (x[3] ^ other.x[3])) == 0;
+    }
+
+    bool operator!=(const Secp256k1Field& other) const
+    {
+        return not (*this == other);
+    }
+
+    Secp256k1Field operator+(const Secp256k1Field& other) const
+    {
+        Secp256k1Field res;
+        u128 t = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            t += u128(x[i]) + other.x[i];
+            res.x[i] = t;
+            t >>= 64;
+        }
+        res.reduce(t);
+        return res;
+    }
+
+    Secp256k1Field operator-(const Secp256k1Field& other) const
+    {
+        Secp256k1Field res;
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            u128 t = u128(x[i]) - other.x[i] - borrow;
+            res.x[i] = t;
+            borrow = (t >> 64) & 1;
+        }
+        // add p back after borrow, that is, subtract C
+        uint64_t mask = -borrow;
+        borrow = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            u128 t = u128(res.x[i]) - ((i == 0 ? C : 0) & mask) - borrow;
+            res.x[i] = t;
+            borrow = (t >> 64) & 1;
+        }
+        return res;
+    }
+
+    Secp256k1Field operator-() const
+    {
+        return Secp256k1Field() - *this;
+    }
+
+    Secp256k1Field operator*(const Secp256k1Field& other) const
+    {
+        uint64_t prod[8] = {};
+        for (int i = 0; i < 4; i++)
+        {
+            u128 t = 0;
+            for (int j = 0; j < 4; j++)
+            {
+                t += u128(x[i]) * other.x[j] + prod[i + j];
+                prod[i + j] = t;
+                t >>= 64;
+            }
+            prod[i + 4] = t;
+        }
+
+        // fold upper half using 2^256 = C mod p
+        Secp256k1Field res;
+        u128 t = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            t += u128(prod[i + 4]) * C + prod[i];
+            res.x[i] = t;
+            t >>= 64;
+        }
+        res.reduce(t);
+        return res;
+    }
+
+    Secp256k1Field operator*(uint64_t other) const
+    {
+        Secp256k1Field res;
+        u128 t = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            t += u128(x[i]) * other;
+            res.x[i] = t;
+            t >>= 64;
+        }
+        res.reduce(t);
+        return res;
+    }
+
+    Secp256k1Field sqr() const
+    {
+        return *this * *this;
+    }
+
+    Secp256k1Field& operator+=(const Secp256k1Field& other)
+    {
+        return *this = *this + other;
+    }
+
+    Secp256k1Field& operator-=(const Secp256k1Field& other)
+    {
+        return *this = *this - other;
+    }
+
+    Secp256k1Field& operator*=(const Secp256k1Field& other)
+    {
+        return *this = *this * other;
+    }
+
+    // fixed 4-bit window, exponent is public
+    Secp256k1Field pow(const uint64_t* exponent) const
+    {
+        Secp256k1Field table[16];
+        table[0] = 1;
+        for (int i = 1; i < 16; i++)
+            table[i] = table[i - 1] * *this;
+        Secp256k1Field res = 1;
+        for (int i = 63; i >= 0; i--)
+        {
+            for (int j = 0; j < 4; j++)
+                res = res.sqr();
+            res *= table[(exponent[i / 16] >> (4 * (i % 16))) & 0xF];
+        }
+        return res;
+    }
+
+    Secp256k1Field invert() const
+    {
+        uint64_t e[4] = { P[0] - 2, P[1], P[2], P[3] };
+        return pow(e);
+    }
+
+    // square root if there is one, p = 3 mod 4
+    Secp256k1Field sqrt() const
+    {
+        uint64_t e[4] = { (P[0] >> 2) | (P[1] << 62) , (P[1] >> 2) | (P[2] << 62),
+                (P[2] >> 2) | (P[3] << 62), P[3] >> 2 };
+        // (p + 1) / 4 = (p >> 2) + 1 because p = 3 mod 4
+        e[0] += 1;
+        return pow(e);
+    }
+};
+
+#endif /* ECDSA_SECP256K1FIELD_H_ */
@@ -21,6 +21,7 @@
 
 #include "ECDSA/preprocessing.hpp"
 #include "ECDSA/sign.hpp"
+#include "ECDSA/sign-service.hpp"
 #include "Protocols/MaliciousRepMC.hpp"
 #include "Protocols/Beaver.hpp"
 #include "Protocols/fake-stuff.hpp"
@@ -80,6 +81,27 @@ void run(int argc, const char** argv)
     vector<EcTuple<T>> tuples;
     preprocessing<T>(tuples, n_tuples, sk, proc, opts);
 //    check(tuples, sk, {}, P);
-    sign_benchmark<T>(tuples, sk, MCp, P, opts, prep_mul ? 0 : &proc);
+    if (opts.service())
+    {
+        // separate connections for preprocessing in the background
+        CryptoPlayer prep_P(N, "ecdsa-prep");
+        EcTuplePool<T> pool(tuples, max(opts.max_batch, n_tuples / 2),
+                [&](vector<EcTuple<T>>& new_tuples)
+                {
+                    DataPositions prep_usage;
+                    typename pShare::TriplePrep bg_prep(0, prep_usage);
+                    typename pShare::MAC_Check bg_MC(mac_key);
+                    ArithmeticProcessor bg_proc({}, 0);
+                    SubProcessor<pShare> bg_subproc(bg_proc, bg_MC, bg_prep,
+                            prep_P);
+                    preprocessing<T>(new_tuples, n_tuples, sk, bg_subproc,
+                            opts);
+                    bg_MC.Check(prep_P);
+                });
+        EcSigningService<T>(P, opts).run(pool, sk, MCp,
+                prep_mul ? 0 : &proc);
+    }
+    else
+        sign_benchmark<T>(tuples, sk, MCp, P, opts, prep_mul ? 0 : &proc);
     P256Element::finish();
 }
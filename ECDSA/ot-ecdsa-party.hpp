@@ -13,6 +13,7 @@
 
 #include "ECDSA/preprocessing.hpp"
 #include "ECDSA/sign.hpp"
+#include "ECDSA/sign-service.hpp"
 #include "Protocols/Beaver.hpp"
 #include "Protocols/fake-stuff.hpp"
 #include "Protocols/MascotPrep.hpp"
@@ -138,7 +139,31 @@ void run(int argc, const char** argv)
     vector<EcTuple<T>> tuples;
     preprocessing(tuples, n_tuples, sk, proc, opts);
     //check(tuples, sk, keyp, P);
-    sign_benchmark(tuples, sk, MCp, P, opts, prep_mul ? 0 : &proc);
+    if (opts.service())
+    {
+        // separate connections for preprocessing in the background
+        PlainPlayer prep_P(N, "ecdsa-prep");
+        EcTuplePool<T> pool(tuples, max(opts.max_batch, n_tuples / 2),
+                [&](vector<EcTuple<T>>& new_tuples)
+                {
+                    DataPositions prep_usage;
+                    typename pShare::TriplePrep bg_prep(0, prep_usage);
+                    bg_prep.params = prep.params;
+                    typename pShare::Direct_MC bg_MC(keyp);
+                    ArithmeticProcessor bg_proc({}, 0);
+                    SubProcessor<pShare> bg_subproc(bg_proc, bg_MC, bg_prep,
+                            prep_P);
+                    typename pShare::prep_type::Direct_MC bg_MCpp(keyp);
+                    bg_prep.triple_generator->MC = &bg_MCpp;
+                    preprocessing(new_tuples, n_tuples, sk, bg_subproc, opts);
+                    if (bg_prep.params.generateMACs)
+                        bg_MC.Check(prep_P);
+                });
+        EcSigningService<T>(P, opts).run(pool, sk, MCp,
+                prep_mul ? 0 : &proc);
+    }
+    else
+        sign_benchmark(tuples, sk, MCp, P, opts, prep_mul ? 0 : &proc);
 
     pShare::MAC_Check::teardown();
     T<P256Element>::MAC_Check::teardown();
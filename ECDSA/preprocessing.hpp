@@ -92,6 +92,8 @@ void preprocessing(vector<EcTuple<T>>& tuples, int buffer_size,
         if (opts.fewer_rounds)
             for (int i = 0; i < buffer_size; i++)
                 opened_Rs[i] /= cs_opened[i];
+        // one inversion for all x coordinates used in signing
+        P256Element::batch_normalize(opened_Rs);
     }
     if (prep_mul)
         protocol.stop_exchange();
@@ -0,0 +1,533 @@
+/*
+ * sign-service.hpp
+ *
+ */
+
+#ifndef ECDSA_SIGN_SERVICE_HPP_
+#define ECDSA_SIGN_SERVICE_HPP_
+
+#include "sign.hpp"
+#include "Processor/ExternalClients.h"
+#include "Tools/WaitQueue.h"
+#include "Tools/Bundle.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <sys/socket.h>
+#include <poll.h>
+
+/*
+ * Tuples for signing, refilled in the background whenever fewer than
+ * the low-water mark remain. This only depends on the number of tuples
+ * generated and used, so all parties refill at the same points.
+ */
+template<template<class U> class T>
+class EcTuplePool
+{
+public:
+    typedef function<void(vector<EcTuple<T>>&)> refill_type;
+
+private:
+    deque<EcTuple<T>> tuples;
+    size_t low_water;
+    refill_type refill;
+    bool stopping;
+    mutex lock;
+    condition_variable cond;
+    thread refiller;
+    Timer refill_timer;
+    int n_refills;
+
+    void run()
+    {
+        bigint::init_thread();
+        unique_lock<mutex> l(lock);
+        while (true)
+        {
+            cond.wait(l, [this] {
+                return stopping or tuples.size() < low_water;
+            });
+            // finish refills that the other parties might be running
+            if (tuples.size() >= low_water)
+                break;
+            l.unlock();
+            vector<EcTuple<T>> new_tuples;
+            refill_timer.start();
+            refill(new_tuples);
+            refill_timer.stop();
+            l.lock();
+            tuples.insert(tuples.end(), new_tuples.begin(), new_tuples.end());
+            n_refills++;
+            cond.notify_all();
+        }
+    }
+
+public:
+    EcTuplePool(vector<EcTuple<T>>& initial, size_t low_water,
+            refill_type refill) :
+            tuples(initial.begin(), initial.end()), low_water(low_water),
+            refill(refill), stopping(false), n_refills(0)
+    {
+        refiller = thread([this] { run(); });
+    }
+
+    ~EcTuplePool()
+    {
+        stop();
+    }
+
+    vector<EcTuple<T>> take(size_t n)
+    {
+        if (n > low_water)
+            throw runtime_error("batch larger than the tuple low-water mark");
+        unique_lock<mutex> l(lock);
+        cond.wait(l, [this, n] { return tuples.size() >= n; });
+        vector<EcTuple<T>> res(tuples.begin(), tuples.begin() + n);
+        tuples.erase(tuples.begin(), tuples.begin() + n);
+        cond.notify_all();
+        return res;
+    }
+
+    void stop()
+    {
+        if (not refiller.joinable())
+            return;
+        {
+            lock_guard<mutex> l(lock);
+            stopping = true;
+        }
+        cond.notify_all();
+        refiller.join();
+        cout << "Refilled tuples " << n_refills << " times in the background in "
+                << refill_timer.elapsed() << " seconds" << endl;
+    }
+};
+
+class EcSignRequest
+{
+public:
+    P256Element::Scalar hash;
+    int client_id;
+    chrono::steady_clock::time_point arrival;
+};
+
+/*
+ * Long-running signing with requests from external clients
+ * or a built-in load generator. Party 0 decides which pending requests
+ * to sign together, and all signatures of a batch share the openings.
+ * Clients have to send every message to all parties, which reply
+ * with the signature (R and s). Requests that do not reach all parties
+ * with the same content within a few seconds are dropped together
+ * with the client. The service stops after the generated load or
+ * after opts.service_timeout seconds without requests.
+ */
+template<template<class U> class T>
+class EcSigningService
+{
+    // source of generated requests
+    static const int GENERATOR = -1;
+    // seconds to wait for a request that party 0 has already received
+    static const int REQUEST_TIMEOUT = 5;
+
+    Player& P;
+    EcdsaOptions& opts;
+    ExternalClients clients;
+
+    WaitQueue<int> arrivals;
+    map<int, WaitQueue<EcSignRequest>*> sources;
+    set<int> dropped;
+    mutex sources_lock;
+
+    PRNG load_prng;
+    atomic<bool> stopping;
+    thread generator, acceptor;
+    map<int, thread> readers;
+    // all I/O on a TLS stream has to be serialized
+    map<int, timed_mutex*> io_locks;
+    mutex readers_lock;
+    size_t n_dropped;
+
+    WaitQueue<EcSignRequest>& source(int id)
+    {
+        lock_guard<mutex> l(sources_lock);
+        auto& res = sources[id];
+        if (res == 0)
+            res = new WaitQueue<EcSignRequest>;
+        return *res;
+    }
+
+    bool is_dropped(int id)
+    {
+        lock_guard<mutex> l(sources_lock);
+        return dropped.count(id);
+    }
+
+    void push(const EcSignRequest& request)
+    {
+        if (is_dropped(request.client_id))
+            return;
+        source(request.client_id).push(request);
+        if (P.my_num() == 0)
+            arrivals.push(request.client_id);
+    }
+
+    void generate()
+    {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < opts.load_requests and not stopping; i++)
+        {
+            this_thread::sleep_until(
+                    start + chrono::microseconds(long(1e6 * i / opts.load_rate)));
+            unsigned char message[32];
+            load_prng.get_octets(message, sizeof(message));
+            push({hash_to_scalar(message, sizeof(message)), GENERATOR,
+                chrono::steady_clock::now()});
+        }
+    }
+
+    void accept()
+    {
+        while (not stopping)
+        {
+            int client_id = clients.get_client_connection(opts.service_port, 1);
+            lock_guard<mutex> l(readers_lock);
+            if (client_id >= 0)
+            {
+                io_locks[client_id] = new timed_mutex;
+                readers[client_id] = thread([this, client_id] { read(client_id); });
+            }
+        }
+    }
+
+    timed_mutex& io_lock(int client_id)
+    {
+        lock_guard<mutex> l(readers_lock);
+        return *io_locks.at(client_id);
+    }
+
+    void read(int client_id)
+    {
+        auto socket = clients.get_socket(client_id);
+        auto& lock = io_lock(client_id);
+        pollfd fd = {socket->lowest_layer().native_handle(), POLLIN, 0};
+        try
+        {
+            while (not stopping)
+            {
+                // only hold the lock once a request is arriving
+                // so that replies can be sent in the meantime
+                unique_lock<timed_mutex> l(lock);
+                if (SSL_pending(socket->native_handle()) == 0)
+                {
+                    l.unlock();
+                    if (poll(&fd, 1, 100) <= 0)
+                        continue;
+                    l.lock();
+                }
+                octetStream os;
+                os.Receive(socket);
+                l.unlock();
+                push({hash_to_scalar(os.get_data(), os.get_length()),
+                    client_id, chrono::steady_clock::now()});
+            }
+        }
+        catch (exception& e)
+        {
+            if (OnlineOptions::singleton.verbose)
+                cerr << "Client " << client_id << " gone: " << e.what()
+                        << endl;
+        }
+    }
+
+    void disconnect(int client_id)
+    {
+        ::shutdown(clients.get_socket(client_id)->lowest_layer().native_handle(),
+                SHUT_RDWR);
+    }
+
+    void drop(int client_id)
+    {
+        {
+            lock_guard<mutex> l(sources_lock);
+            dropped.insert(client_id);
+        }
+        lock_guard<mutex> l(readers_lock);
+        if (readers.count(client_id))
+            disconnect(client_id);
+        n_dropped++;
+    }
+
+    // party 0 waits for the next request unless the service should stop
+    bool wait_for_arrival(int& next, int n_generated)
+    {
+        if (opts.service_port < 0)
+            return n_generated > 0 and arrivals.pop(next);
+
+        auto idle_since = chrono::steady_clock::now();
+        while (true)
+        {
+            while (arrivals.pop_for(next, 1))
+                if (not is_dropped(next))
+                    return true;
+            if (n_generated > 0)
+                continue;
+            if (opts.service_timeout > 0
+                    and chrono::steady_clock::now() - idle_since
+                            > chrono::seconds(opts.service_timeout))
+                return false;
+        }
+    }
+
+    vector<int> next_batch(int& n_generated)
+    {
+        octetStream os;
+        vector<int> batch;
+        if (P.my_num() == 0)
+        {
+            int next;
+            if (wait_for_arrival(next, n_generated))
+            {
+                batch.push_back(next);
+                while (batch.size() < size_t(opts.max_batch)
+                        and arrivals.try_pop(next))
+                    if (not is_dropped(next))
+                        batch.push_back(next);
+            }
+            os.store(batch.size());
+            for (int id : batch)
+                os.store(id);
+            P.send_all(os);
+        }
+        else
+        {
+            P.receive_player(0, os);
+            batch.resize(os.get<size_t>());
+            for (int& id : batch)
+                os.get(id);
+        }
+        n_generated -= count(batch.begin(), batch.end(), GENERATOR);
+        return batch;
+    }
+
+    /*
+     * Requests of a batch that all parties have received
+     * with the same content. The others are dropped everywhere.
+     */
+    vector<EcSignRequest> collect(const vector<int>& batch)
+    {
+        vector<EcSignRequest> requests(batch.size());
+        vector<int> present(batch.size(), 1);
+        bool external = false;
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            int id = batch[i];
+            if (id == GENERATOR)
+                source(id).pop(requests[i]);
+            else
+            {
+                external = true;
+                present[i] = not is_dropped(id)
+                        and source(id).pop_for(requests[i], REQUEST_TIMEOUT);
+            }
+        }
+
+        if (external)
+        {
+            Bundle<octetStream> bundle(P);
+            for (size_t i = 0; i < batch.size(); i++)
+                if (batch[i] != GENERATOR)
+                {
+                    bundle.mine.store(present[i]);
+                    if (present[i])
+                        requests[i].hash.pack(bundle.mine);
+                }
+            P.Broadcast_Receive(bundle);
+
+            vector<int> agreed = present;
+            for (int j = 0; j < P.num_players(); j++)
+            {
+                if (j == P.my_num())
+                    continue;
+                for (size_t i = 0; i < batch.size(); i++)
+                    if (batch[i] != GENERATOR)
+                    {
+                        int their_present;
+                        bundle[j].get(their_present);
+                        if (their_present)
+                        {
+                            P256Element::Scalar hash;
+                            hash.unpack(bundle[j]);
+                            if (present[i] and hash != requests[i].hash)
+                                agreed[i] = 0;
+                        }
+                        else
+                            agreed[i] = 0;
+                    }
+            }
+
+            vector<EcSignRequest> res;
+            for (size_t i = 0; i < batch.size(); i++)
+                if (agreed[i])
+                    res.push_back(requests[i]);
+                else if (not is_dropped(batch[i]))
+                {
+                    cerr << "Dropping client " << batch[i]
+                            << " after incomplete request" << endl;
+                    drop(batch[i]);
+                }
+            return res;
+        }
+
+        return requests;
+    }
+
+    void send_signature(int client_id, const EcSignature& signature)
+    {
+        octetStream reply;
+        signature.R.pack(reply);
+        signature.s.pack(reply);
+        unique_lock<timed_mutex> l(io_lock(client_id),
+                chrono::seconds(REQUEST_TIMEOUT));
+        if (not l.owns_lock())
+        {
+            cerr << "Dropping client " << client_id
+                    << " after blocking the connection" << endl;
+            drop(client_id);
+            return;
+        }
+        try
+        {
+            reply.Send(clients.get_socket(client_id));
+        }
+        catch (exception& e)
+        {
+            if (OnlineOptions::singleton.verbose)
+                cerr << "Cannot reply to client " << client_id << ": "
+                        << e.what() << endl;
+        }
+    }
+
+    void shut_down()
+    {
+        stopping = true;
+        if (generator.joinable())
+            generator.join();
+        if (acceptor.joinable())
+            acceptor.join();
+        for (auto& reader : readers)
+        {
+            disconnect(reader.first);
+            reader.second.join();
+        }
+    }
+
+public:
+    EcSigningService(Player& P, EcdsaOptions& opts) :
+            P(P), opts(opts), clients(P.my_num()), stopping(false),
+            n_dropped(0)
+    {
+        if (opts.max_batch < 1)
+            throw runtime_error("batch size has to be positive");
+    }
+
+    ~EcSigningService()
+    {
+        shut_down();
+        for (auto& source : sources)
+            delete source.second;
+        for (auto& lock : io_locks)
+            delete lock.second;
+    }
+
+    void run(EcTuplePool<T>& pool, T<P256Element::Scalar> sk,
+            typename T<P256Element::Scalar>::MAC_Check& MCp,
+            SubProcessor<T<P256Element::Scalar>>* proc = 0)
+    {
+        typename T<P256Element>::Direct_MC MCc(MCp.get_alphai());
+        P256Element pk = MCc.open(sk, P);
+        MCc.Check(P);
+        cout << "Public key: " << pk << endl;
+
+        int n_generated = 0;
+        if (opts.load_rate > 0)
+        {
+            // same messages everywhere
+            GlobalPRNG G(P);
+            load_prng.SetSeed(G);
+            n_generated = opts.load_requests;
+            generator = thread([this] { generate(); });
+        }
+
+        if (opts.service_port >= 0)
+        {
+            clients.start_listening(opts.service_port);
+            acceptor = thread([this] { accept(); });
+        }
+
+        vector<double> latencies;
+        size_t n_batches = 0;
+        Timer timer;
+        timer.start();
+        auto stats = P.total_comm();
+
+        while (true)
+        {
+            auto batch = next_batch(n_generated);
+            if (batch.empty())
+                break;
+
+            auto requests = collect(batch);
+            if (requests.empty())
+                continue;
+            vector<P256Element::Scalar> hashes;
+            for (auto& request : requests)
+                hashes.push_back(request.hash);
+
+            auto signatures = sign_batch<T>(hashes, pool.take(requests.size()),
+                    MCp, MCc, P, opts, sk, proc);
+            if (opts.check_open)
+            {
+                MCp.Check(P);
+                MCc.Check(P);
+            }
+
+            auto now = chrono::steady_clock::now();
+            for (size_t i = 0; i < requests.size(); i++)
+            {
+                auto& request = requests[i];
+                latencies.push_back(
+                        chrono::duration<double>(now - request.arrival).count());
+                if (request.client_id != GENERATOR)
+                    send_signature(request.client_id, signatures[i]);
+            }
+            n_batches++;
+        }
+
+        timer.stop();
+        shut_down();
+        pool.stop();
+
+        size_t n = latencies.size();
+        cout << "Signed " << n << " messages in " << n_batches << " batches in "
+                << timer.elapsed() << " seconds, " << n / timer.elapsed()
+                << " signatures per second" << endl;
+        if (n_dropped)
+            cout << "Dropped " << n_dropped << " clients" << endl;
+        if (n > 0)
+        {
+            sort(latencies.begin(), latencies.end());
+            cout << "Latency median " << latencies[n / 2] * 1e3 << " ms, p99 "
+                    << latencies[min(n - 1, size_t(0.99 * n))] * 1e3 << " ms"
+                    << endl;
+        }
+        (P.total_comm() - stats).print(true);
+    }
+};
+
+#endif /* ECDSA_SIGN_SERVICE_HPP_ */
@@ -52,49 +52,89 @@ inline P256Element::Scalar hash_to_scalar(const unsigned char* message, size_t l
     return res;
 }
 
+/*
+ * Signs several message hashes at once, so that all signatures
+ * share the same rounds of multiplication and opening.
+ */
 template<template<class U> class T>
-EcSignature sign(const unsigned char* message, size_t length,
-        EcTuple<T> tuple,
+vector<EcSignature> sign_batch(const vector<P256Element::Scalar>& hashes,
+        vector<EcTuple<T>> tuples,
         typename T<P256Element::Scalar>::MAC_Check& MC,
         typename T<P256Element>::MAC_Check& MCc,
         Player& P,
         EcdsaOptions opts,
-        P256Element pk,
         T<P256Element::Scalar> sk = {},
         SubProcessor<T<P256Element::Scalar>>* proc = 0)
 {
-    (void) pk;
-    Timer timer;
-    timer.start();
-    auto stats = P.total_comm();
-    EcSignature signature;
+    size_t n = hashes.size();
+    assert(tuples.size() >= n);
+    vector<EcSignature> signatures(n);
     vector<P256Element> opened_R;
+    vector<T<P256Element>> secret_R;
     if (opts.R_after_msg)
-        MCc.POpen_Begin(opened_R, {tuple.secret_R}, P);
-    T<P256Element::Scalar> prod = tuple.b;
-    auto& protocol = proc->protocol;
+    {
+        for (size_t i = 0; i < n; i++)
+            secret_R.push_back(tuples[i].secret_R);
+        MCc.POpen_Begin(opened_R, secret_R, P);
+    }
+    vector<T<P256Element::Scalar>> prods;
+    for (size_t i = 0; i < n; i++)
+        prods.push_back(tuples[i].b);
     if (proc)
     {
+        auto& protocol = proc->protocol;
         protocol.init_mul();
-        protocol.prepare_mul(sk, tuple.a);
+        for (size_t i = 0; i < n; i++)
+            protocol.prepare_mul(sk, tuples[i].a);
         protocol.start_exchange();
     }
     if (opts.R_after_msg)
     {
-        MCc.POpen_End(opened_R, {tuple.secret_R}, P);
-        tuple.R = opened_R[0];
-        if (opts.fewer_rounds)
-            tuple.R /= tuple.c;
+        MCc.POpen_End(opened_R, secret_R, P);
+        for (size_t i = 0; i < n; i++)
+        {
+            tuples[i].R = opened_R[i];
+            if (opts.fewer_rounds)
+                tuples[i].R /= tuples[i].c;
+        }
     }
     if (proc)
     {
+        auto& protocol = proc->protocol;
         protocol.stop_exchange();
-        prod = protocol.finalize_mul();
+        for (size_t i = 0; i < n; i++)
+            prods[i] = protocol.finalize_mul();
     }
-    signature.R = tuple.R;
-    auto rx = tuple.R.x();
-    signature.s = MC.open(
-            tuple.a * hash_to_scalar(message, length) + prod * rx, P);
+    vector<T<P256Element::Scalar>> secret_s;
+    for (size_t i = 0; i < n; i++)
+    {
+        signatures[i].R = tuples[i].R;
+        secret_s.push_back(tuples[i].a * hashes[i] + prods[i] * tuples[i].R.x());
+    }
+    vector<P256Element::Scalar> opened_s;
+    MC.POpen(opened_s, secret_s, P);
+    for (size_t i = 0; i < n; i++)
+        signatures[i].s = opened_s[i];
+    return signatures;
+}
+
+template<template<class U> class T>
+EcSignature sign(const unsigned char* message, size_t length,
+        EcTuple<T> tuple,
+        typename T<P256Element::Scalar>::MAC_Check& MC,
+        typename T<P256Element>::MAC_Check& MCc,
+        Player& P,
+        EcdsaOptions opts,
+        P256Element pk,
+        T<P256Element::Scalar> sk = {},
+        SubProcessor<T<P256Element::Scalar>>* proc = 0)
+{
+    (void) pk;
+    Timer timer;
+    timer.start();
+    auto stats = P.total_comm();
+    EcSignature signature = sign_batch<T>({hash_to_scalar(message, length)},
+            {tuple}, MC, MCc, P, opts, sk, proc)[0];
     auto diff = (P.total_comm() - stats);
     cout << "Minimal signing took " << timer.elapsed() * 1e3 << " ms and sending "
             << diff.sent << " bytes" << endl;
@@ -124,7 +164,7 @@ void check(EcSignature signature, const unsigned char* message, size_t length,
     auto w = signature.s.invert();
     auto u1 = hash_to_scalar(message, length) * w;
     auto u2 = signature.R.x() * w;
-    assert(P256Element(u1) + pk * u2 == signature.R);
+    assert(P256Element::multi_mul({P256Element(1), pk}, {u1, u2}) == signature.R);
     cout << "Offline checking took " << timer.elapsed() * 1e3 << " ms" << endl;
 }
 
@@ -0,0 +1,102 @@
+/*
+ * test-secp256k1.cpp
+ *
+ * Known-answer tests for the secp256k1 arithmetic in P256Element.
+ * The expected points are the compressed encodings of k * G
+ * from the widely published secp256k1 test vectors.
+ */
+
+#include "ECDSA/P256Element.h"
+#include "Math/gfp.hpp"
+
+#include <sstream>
+
+typedef P256Element::Scalar Scalar;
+
+class KnownPoint
+{
+public:
+    const char* k;
+    const char* point;
+};
+
+const KnownPoint known_points[] = {
+    { "1", "0279BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798" },
+    { "2", "02C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5" },
+    { "3", "02F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9" },
+    { "7", "025CBDF0646E5DB4EAA398F365F2EA7A0E3D419B7E0330E39CE92BDDEDCAC4F9BC" },
+    { "112233445566778899",
+            "02A90CC3D3F3E146DAADFC74CA1372207CB4B725AE708CEF713A98EDD73D99EF29" },
+    { "340282366920938463463374607431768211457",
+            "038B300E513EFF872CDAA6D12DF54A3E332F27CE937BE77E3E63C5E885114CBF09" },
+    { "115792089237316195423570985008687907852837564279074904382605163141518161494335",
+            "03C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5" },
+    { "115792089237316195423570985008687907852837564279074904382605163141518161494336",
+            "0379BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798" },
+};
+
+int n_failures = 0;
+
+void expect(const P256Element& x, const string& expected, const string& what)
+{
+    stringstream ss;
+    ss << x;
+    if (ss.str() != expected)
+    {
+        cerr << what << ": got " << ss.str() << ", expected " << expected
+                << endl;
+        n_failures++;
+    }
+}
+
+P256Element point(int k)
+{
+    return Scalar(k);
+}
+
+int main()
+{
+    P256Element::init();
+
+    P256Element generator = point(1);
+    for (auto& known : known_points)
+    {
+        Scalar k = bigint(known.k);
+        string what = string(known.k) + " * G";
+        expect(P256Element(k), known.point, what + " (fixed base)");
+        expect(generator * k, known.point, what + " (variable base)");
+        expect(P256Element::multi_mul({generator}, {k}), known.point,
+                what + " (multi_mul)");
+
+        octetStream os;
+        P256Element(k).pack(os);
+        P256Element unpacked;
+        unpacked.unpack(os);
+        expect(unpacked, known.point, what + " (unpacked)");
+    }
+
+    expect(point(1) + point(2), known_points[2].point, "G + 2G");
+    expect(point(2) + point(1), known_points[2].point, "2G + G");
+    expect(point(1) + point(1), known_points[1].point, "G + G");
+    expect(point(3) - point(1), known_points[1].point, "3G - G");
+    expect(point(3) + point(2) + point(2), known_points[3].point,
+            "3G + 2G + 2G");
+    expect(point(1) - point(1), "00", "G - G");
+    expect(point(1) + P256Element(), known_points[0].point, "G + O");
+    expect(P256Element() + point(1), known_points[0].point, "O + G");
+    expect(P256Element(Scalar()), "00", "0 * G");
+    expect(generator * Scalar(), "00", "G * 0");
+    expect(P256Element::multi_mul({point(1), point(2)}, {2, 1}) + point(3),
+            known_points[3].point, "2 * G + 1 * 2G + 3G");
+    expect(P256Element::multi_mul({point(1), point(2)}, {1, -1}),
+            known_points[7].point, "G - 2G");
+
+    P256Element::finish();
+
+    if (n_failures)
+    {
+        cerr << n_failures << " failures" << endl;
+        return 1;
+    }
+    cout << "All secp256k1 tests passed" << endl;
+}
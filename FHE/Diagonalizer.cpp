@@ -5,6 +5,12 @@
 
 #include "Diagonalizer.h"
 
+size_t Diagonalizer::n_groups(size_t n_rows, size_t n_matrices,
+        size_t n_slots)
+{
+    return DIV_CEIL(n_rows * n_matrices, n_slots);
+}
+
 Diagonalizer::Diagonalizer(const MatrixVector& matrices,
         const FFT_Data& FTD, const FHE_PK& pk) :
         FTD(FTD)
@@ -18,31 +24,44 @@ Diagonalizer::Diagonalizer(const MatrixVector& matrices,
 
     n_rows = matrices[0].n_rows;
     n_cols = matrices[0].n_cols;
-    assert(n_rows * matrices.size() <= size_t(FTD.num_slots()));
-    for (size_t i = 0; i < n_cols; i++)
-    {
-        Plaintext_<FFT_Data> plaintext(FTD, Evaluation);
-        for (size_t k = 0; k < matrices.size(); k++)
+    n_matrices = matrices.size();
+    size_t n_slots = FTD.num_slots();
+    for (size_t g = 0; g < n_groups(); g++)
+        for (size_t i = 0; i < n_cols; i++)
         {
-            for (size_t j = 0; j < n_rows; j++)
+            Plaintext_<FFT_Data> plaintext(FTD, Evaluation);
+            size_t end = min(n_slots, n_rows * n_matrices - g * n_slots);
+            for (size_t s = 0; s < end; s++)
             {
+                size_t r = g * n_slots + s;
+                size_t k = r / n_rows, j = r % n_rows;
                 auto entry = matrices.at(k)[{j, (j + i) % n_cols}];
-                plaintext.set_element(k * n_rows + j, entry);
+                plaintext.set_element(s, entry);
             }
+            ciphertexts.push_back(pk.encrypt(plaintext));
         }
-        ciphertexts.push_back(pk.encrypt(plaintext));
-    }
+}
+
+size_t Diagonalizer::n_groups() const
+{
+    return n_groups(n_rows, n_matrices, FTD.num_slots());
 }
 
 Plaintext_<FFT_Data> Diagonalizer::get_plaintext(
         const MatrixVector& matrices, int left_col,
-        int right_col)
+        int right_col, int group)
 {
+    assert(matrices.size() == n_matrices);
     Plaintext_<FFT_Data> plaintext(FTD, Evaluation);
-    for (size_t k = 0; k < matrices.size(); k++)
-        for (size_t j = 0; j < n_rows; j++)
-            plaintext.set_element(k * n_rows + j,
-                    matrices.at(k)[{(left_col + j) % n_cols, right_col}]);
+    size_t n_slots = FTD.num_slots();
+    size_t end = min(n_slots, n_rows * n_matrices - group * n_slots);
+    for (size_t s = 0; s < end; s++)
+    {
+        size_t r = group * n_slots + s;
+        size_t k = r / n_rows, j = r % n_rows;
+        plaintext.set_element(s,
+                matrices.at(k)[{(left_col + j) % n_cols, right_col}]);
+    }
     return plaintext;
 }
 
@@ -58,17 +77,23 @@ Diagonalizer::MatrixVector Diagonalizer::decrypt(
 Diagonalizer::MatrixVector Diagonalizer::dediag(
         const vector<Plaintext_<FFT_Data>>& products, int n_matrices)
 {
-    int n_cols_out = products.size();
+    size_t n_slots = FTD.num_slots();
+    size_t n_groups = this->n_groups(n_rows, n_matrices, n_slots);
+    assert(products.size() % n_groups == 0);
+    int n_cols_out = products.size() / n_groups;
     MatrixVector res(n_matrices, {int(n_rows), n_cols_out});
-    for (int i = 0; i < n_cols_out; i++)
-    {
-        auto& c = products.at(i);
-        for (int j = 0; j < n_matrices; j++)
+    for (auto& matrix : res)
+        matrix.entries.init();
+    for (size_t g = 0; g < n_groups; g++)
+        for (int i = 0; i < n_cols_out; i++)
         {
-            res.at(j).entries.init();
-            for (size_t k = 0; k < n_rows; k++)
-                res.at(j)[{k, i}] = c.element(j * n_rows + k);
+            auto& c = products.at(g * n_cols_out + i);
+            size_t end = min(n_slots, n_rows * n_matrices - g * n_slots);
+            for (size_t s = 0; s < end; s++)
+            {
+                size_t r = g * n_slots + s;
+                res.at(r / n_rows)[{r % n_rows, i}] = c.element(s);
+            }
         }
-    }
     return res;
 }
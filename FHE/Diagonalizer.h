@@ -10,25 +10,37 @@
 #include "Ciphertext.h"
 #include "Protocols/ShareMatrix.h"
 
+/**
+ * Packing of matrices in generalized diagonals. The rows of all
+ * matrices are stacked, and the stack is split into groups of slots if
+ * it doesn't fit into one plaintext. This allows rectangular products
+ * with more rows than slots without any rotations.
+ */
 class Diagonalizer
 {
     const FFT_Data& FTD;
 
-    size_t n_rows, n_cols;
+    size_t n_rows, n_cols, n_matrices;
 
 public:
     typedef AddableVector<ValueMatrix<gfpvar>> MatrixVector;
 
+    // indexed by group * n_cols + column
     vector<Ciphertext> ciphertexts;
 
+    static size_t n_groups(size_t n_rows, size_t n_matrices, size_t n_slots);
+
     Diagonalizer(const MatrixVector& matrices,
             const FFT_Data& FTD, const FHE_PK& pk);
 
+    size_t n_groups() const;
+
     Plaintext_<FFT_Data> get_plaintext(const MatrixVector& matrices,
-            int left_col, int right_col);
+            int left_col, int right_col, int group = 0);
 
     MatrixVector decrypt(const vector<Ciphertext>&, int n_matrices, FHE_SK& sk);
 
+    // plaintexts indexed by group * number of output columns + column
     MatrixVector dediag(const vector<Plaintext_<FFT_Data>>& plaintexts,
             int n_matrices);
 };
@@ -178,7 +178,7 @@ void FFT_Iter(vector<modp>& ioput, int n, const vector<modp>& roots,
                 alpha2.push_back(roots.at((j * 2 + 1) * (n / m)));
         }
 
-        if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton())
+        if (BaseMachine::is_main_thread() and BaseMachine::has_singleton())
         {
             auto& queues = BaseMachine::s().queues;
             FftJob job(ioput, alpha2, m, PrD);
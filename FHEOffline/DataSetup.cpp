@@ -220,7 +220,7 @@ void PartSetup<FD>::check(Player& P, MachineBase& machine)
     FieldD.hash(os);
     pk.pack(os);
     calpha.pack(os);
-    bundle.compare(P);
+    bundle.compare_hash(P);
 }
 
 template<class FD>
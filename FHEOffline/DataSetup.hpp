@@ -8,6 +8,7 @@
 
 #include "Networking/Player.h"
 #include "Tools/Bundle.h"
+#include "SetupFile.h"
 
 template<class T, class U, class V>
 void read_or_generate_secrets(T& setup, Player& P, U& machine,
@@ -27,7 +28,7 @@ void read_or_generate_secrets(T& setup, Player& P, U& machine,
 
     try
     {
-        os.input(filename);
+        SetupFile::read(os, filename);
         setup.unpack(os);
         machine.unpack(os);
     }
@@ -56,11 +57,10 @@ void read_or_generate_secrets(T& setup, Player& P, U& machine,
                 "from a previous run was found (" << error << ")" << endl;
         setup.key_and_mac_generation(P, machine, num_runs, V());
 
-        ofstream output(filename);
         octetStream os;
         setup.pack(os);
         machine.pack(os);
-        os.output(output);
+        SetupFile::write(os, filename);
     }
 }
 
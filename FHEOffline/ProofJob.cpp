@@ -0,0 +1,57 @@
+/*
+ * ProofJob.cpp
+ *
+ */
+
+#include "ProofJob.h"
+#include "Protocols/CowGearOptions.h"
+
+#include <assert.h>
+
+int ProofWorkers::default_n_threads()
+{
+    return CowGearOptions::singleton.proof_threads;
+}
+
+ProofWorkers& ProofWorkers::shared()
+{
+    static ProofWorkers workers;
+    return workers;
+}
+
+ProofWorkers::ProofWorkers(int n_threads)
+{
+    assert(n_threads > 0);
+    for (int i = 1; i < n_threads; i++)
+        jobs.push_back(new ProofJob);
+}
+
+ProofWorkers::~ProofWorkers()
+{
+    for (auto job : jobs)
+        delete job;
+}
+
+int ProofWorkers::run(size_t n_items,
+        const function<int(size_t, size_t, int)>& task)
+{
+    size_t n_chunks = min(size_t(n_threads()), n_items);
+    unique_lock<mutex> busy(lock, try_to_lock);
+    if (n_chunks <= 1 or not busy.owns_lock())
+        return task(0, n_items, 0);
+
+    for (size_t i = 1; i < n_chunks; i++)
+        jobs[i - 1]->dispatch(task, i * n_items / n_chunks,
+                (i + 1) * n_items / n_chunks, i);
+
+    int res = task(0, n_items / n_chunks, 0);
+
+    for (size_t i = 1; i < n_chunks; i++)
+    {
+        int job_res = jobs[i - 1]->worker.done();
+        if (res == 0)
+            res = job_res;
+    }
+
+    return res;
+}
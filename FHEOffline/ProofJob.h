@@ -0,0 +1,79 @@
+/*
+ * ProofJob.h
+ *
+ */
+
+#ifndef FHEOFFLINE_PROOFJOB_H_
+#define FHEOFFLINE_PROOFJOB_H_
+
+#include "Tools/time-func.h"
+#include "Tools/Worker.h"
+
+#include <functional>
+#include <vector>
+#include <mutex>
+using namespace std;
+
+/*
+ * Runs a task on a contiguous range of ciphertexts of a proof.
+ * The task returns 0 on success.
+ */
+class ProofJob
+{
+    function<int(size_t, size_t, int)> task;
+    size_t start, end;
+    int thread_num;
+
+public:
+    Worker<ProofJob> worker;
+
+    ProofJob() :
+            start(0), end(0), thread_num(0)
+    {
+    }
+
+    void dispatch(const function<int(size_t, size_t, int)>& task,
+            size_t start, size_t end, int thread_num)
+    {
+        this->task = task;
+        this->start = start;
+        this->end = end;
+        this->thread_num = thread_num;
+        worker.request(*this);
+    }
+
+    int run()
+    {
+        return task(start, end, thread_num);
+    }
+};
+
+/*
+ * Pool of workers splitting the ciphertext vector of a proof.
+ * The calling thread processes the first chunk itself.
+ * If the pool is busy with another proof, the caller does all the work.
+ */
+class ProofWorkers
+{
+    vector<ProofJob*> jobs;
+    mutex lock;
+
+public:
+    static int default_n_threads();
+
+    // one pool per process
+    static ProofWorkers& shared();
+
+    ProofWorkers(int n_threads = default_n_threads());
+    ~ProofWorkers();
+
+    int n_threads() const
+    {
+        return jobs.size() + 1;
+    }
+
+    // returns the first non-zero result or 0
+    int run(size_t n_items, const function<int(size_t, size_t, int)>& task);
+};
+
+#endif /* FHEOFFLINE_PROOFJOB_H_ */
@@ -11,16 +11,23 @@
 
 template <class FD, class U>
 Prover<FD,U>::Prover(Proof& proof, const FD& FieldD) :
+  workers(ProofWorkers::shared()),
+  Gs(workers.n_threads()),
+  rcs(workers.n_threads(), Random_Coins(proof.pk->get_params())),
+  ciphertext_buffers(workers.n_threads(), Ciphertext(proof.pk->get_params())),
+  parts(workers.n_threads()),
   volatile_memory(0)
 {
   s.resize(proof.V, proof.pk->get_params());
   y.resize(proof.V, FieldD);
 #ifdef LESS_ALLOC_MORE_MEM
-  t = s[0];
-  z = y[0];
+  z.resize(workers.n_threads(), y[0]);
+  t.resize(workers.n_threads(), s[0]);
   // extra limb to prevent reallocation
-  t.allocate_slots(bigint(1) << (proof.B_rand_length + 64));
-  z.allocate_slots(bigint(1) << (proof.B_plain_length + 64));
+  for (auto& x : t)
+    x.allocate_slots(bigint(1) << (proof.B_rand_length + 64));
+  for (auto& x : z)
+    x.allocate_slots(bigint(1) << (proof.B_plain_length + 64));
   s.allocate_slots(bigint(1) << proof.B_rand_length);
   y.allocate_slots(bigint(1) << proof.B_plain_length);
 #endif
@@ -44,23 +51,39 @@ void Prover<FD,U>::Stage_1(const Proof& P, octetStream& ciphertexts,
 //  ZZ bd=B_plain/(pr+1);
   PRNG G;
   G.ReSeed();
-  Random_Coins rc(pk.get_params());
-  Ciphertext ciphertext(pk.get_params());
+  // independent stream per thread
+  for (auto& GG : Gs)
+    GG.SetSeed(G);
   ciphertexts.store(V);
-  for (int i=0; i<V; i++)
+  // the pool might run everything in the first chunk if busy
+  for (auto& part : parts)
+    part.reset_write_head();
+  workers.run(V, [&](size_t start, size_t end, int thread_num) -> int
     {
-//      AE.randomize(Diag,binary);
-//      rd=RandPoly(phim,bd<<1);
-//      y[i]=AE.plaintext()+pr*rd;
-      y[i].randomize(G, P.B_plain_length, P.get_diagonal());
-      if (P.get_diagonal())
-        assert(y[i].is_diagonal());
-      s[i].resize(3, P.phim);
-      s[i].generateUniform(G, P.B_rand_length);
-      rc.assign(s[i][0], s[i][1], s[i][2]);
-      pk.encrypt(ciphertext,y[i],rc);
-      ciphertext.pack(ciphertexts);
-    }
+      auto& G = Gs[thread_num];
+      auto& rc = rcs[thread_num];
+      auto& ciphertext = ciphertext_buffers[thread_num];
+      auto& part = parts[thread_num];
+      part.reset_write_head();
+      for (size_t i = start; i < end; i++)
+        {
+//          AE.randomize(Diag,binary);
+//          rd=RandPoly(phim,bd<<1);
+//          y[i]=AE.plaintext()+pr*rd;
+          y[i].randomize(G, P.B_plain_length, P.get_diagonal());
+          if (P.get_diagonal())
+            assert(y[i].is_diagonal());
+          s[i].resize(3, P.phim);
+          s[i].generateUniform(G, P.B_rand_length);
+          rc.assign(s[i][0], s[i][1], s[i][2]);
+          pk.encrypt(ciphertext,y[i],rc);
+          ciphertext.pack(part);
+        }
+      return 0;
+    });
+  // chunks are contiguous, so concatenating preserves the order
+  for (int i = 0; i < min(V, workers.n_threads()); i++)
+    ciphertexts.concat(parts[i]);
 }
 
 
@@ -75,29 +98,44 @@ bool Prover<FD,U>::Stage_2(Proof& P, octetStream& cleartexts,
   cleartexts.resize_precise(allocate);
   cleartexts.reset_write_head();
 
-  unsigned int i;
 #ifndef LESS_ALLOC_MORE_MEM
-  AddableVector<fixint<gfp::N_LIMBS>> z;
-  AddableMatrix<fixint<gfp::N_LIMBS>> t;
+  vector<AddableVector<fixint<gfp::N_LIMBS>>> z(workers.n_threads());
+  vector<AddableMatrix<fixint<gfp::N_LIMBS>>> t(workers.n_threads());
 #endif
   cleartexts.reset_write_head();
   cleartexts.store(P.V);
   if (P.get_diagonal())
     for (auto& xx : x)
       assert(xx.is_diagonal());
-  for (i=0; i<P.V; i++)
-    { z=y[i];
-      t=s[i];
-      P.apply_challenge(i, z, x, pk);
-      Check_Decoding(z, P.get_diagonal(), x[0].get_field());
-      P.apply_challenge(i, t, r, pk);
-      if (not P.check_bounds(z, t, i))
-          return false;
-      z.pack(cleartexts);
-      t.pack(cleartexts);
-   }
+  for (auto& part : parts)
+    part.reset_write_head();
+  int res = workers.run(P.V, [&](size_t start, size_t end, int thread_num) -> int
+    {
+      auto& zz = z[thread_num];
+      auto& tt = t[thread_num];
+      auto& part = parts[thread_num];
+      part.reset_write_head();
+      for (size_t i = start; i < end; i++)
+        { zz=y[i];
+          tt=s[i];
+          P.apply_challenge(i, zz, x, pk);
+          Check_Decoding(zz, P.get_diagonal(), x[0].get_field());
+          P.apply_challenge(i, tt, r, pk);
+          if (not P.check_bounds(zz, tt, i))
+              return 1;
+          zz.pack(part);
+          tt.pack(part);
+       }
+      return 0;
+    });
+  if (res)
+    return false;
+  for (int i = 0; i < min(int(P.V), workers.n_threads()); i++)
+    cleartexts.concat(parts[i]);
 #ifndef LESS_ALLOC_MORE_MEM
-  volatile_memory = t.report_size(CAPACITY) + z.report_size(CAPACITY);
+  volatile_memory = 0;
+  for (int i = 0; i < workers.n_threads(); i++)
+    volatile_memory += t[i].report_size(CAPACITY) + z[i].report_size(CAPACITY);
 #endif
 #ifdef PRINT_MIN_DIST
   cout << "Minimal distance (log) " << log2(P.dist) << ", compare to " <<
@@ -153,8 +191,15 @@ size_t Prover<FD,U>::report_size(ReportType type)
   for (unsigned int i = 0; i < y.size(); i++)
     res += y[i].report_size(type);
 #ifdef LESS_ALLOC_MORE_MEM
-  res += z.report_size(type) + t.report_size(type);
+  for (auto& x : z)
+    res += x.report_size(type);
+  for (auto& x : t)
+    res += x.report_size(type);
 #endif
+  for (auto& x : ciphertext_buffers)
+    res += x.report_size(type);
+  for (auto& x : parts)
+    res += x.get_max_length();
   return res;
 }
 
@@ -165,8 +210,14 @@ void Prover<FD, U>::report_size(ReportType type, MemoryUsage& res)
   res.update("prover s", s.report_size(type));
   res.update("prover y", y.report_size(type));
 #ifdef LESS_ALLOC_MORE_MEM
-  res.update("prover z", z.report_size(type));
-  res.update("prover t", t.report_size(type));
+  size_t zt = 0;
+  for (auto& x : z)
+    zt += x.report_size(type);
+  res.update("prover z", zt);
+  zt = 0;
+  for (auto& x : t)
+    zt += x.report_size(type);
+  res.update("prover t", zt);
 #endif
   res.update("prover volatile", volatile_memory);
 }
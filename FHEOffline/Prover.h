@@ -2,6 +2,7 @@
 #define _Prover
 
 #include "Proof.h"
+#include "ProofJob.h"
 #include "Tools/MemoryUsage.h"
 
 /* Class for the prover */
@@ -14,10 +15,17 @@ class Prover
   AddableVector< Plaintext_<FD> > y;
 
 #ifdef LESS_ALLOC_MORE_MEM
-  AddableVector<typename Proof::bound_type> z;
-  AddableMatrix<Int_Random_Coins::value_type::value_type> t;
+  vector<AddableVector<typename Proof::bound_type>> z;
+  vector<AddableMatrix<Int_Random_Coins::value_type::value_type>> t;
 #endif
 
+  /* Per-thread state for splitting the proof across workers */
+  ProofWorkers& workers;
+  vector<PRNG> Gs;
+  vector<Random_Coins> rcs;
+  vector<Ciphertext> ciphertext_buffers;
+  vector<octetStream> parts;
+
 public:
   size_t volatile_memory;
 
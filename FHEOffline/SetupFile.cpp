@@ -0,0 +1,81 @@
+/*
+ * SetupFile.cpp
+ *
+ */
+
+#include "SetupFile.h"
+#include "Tools/Exceptions.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string.h>
+
+namespace
+{
+
+const char tag[] = "MPSPDZ-FHE-SETUP";
+
+struct SetupFileHeader
+{
+    char tag[sizeof(::tag)];
+    int version;
+    size_t length;
+    unsigned char hash[crypto_generichash_BYTES];
+};
+
+}
+
+void SetupFile::read(octetStream& os, const string& filename)
+{
+    ifstream file(filename, ios::binary);
+    if (not file.good())
+        throw file_error("cannot read from " + filename);
+
+    SetupFileHeader header;
+    file.read((char*) &header, sizeof(header));
+    if (file.gcount() != sizeof(header))
+        throw IO_Error("setup file too short: " + filename);
+
+    if (memcmp(header.tag, tag, sizeof(tag)))
+        throw IO_Error("not a setup file: " + filename);
+    if (header.version != VERSION)
+        throw IO_Error(
+                "setup file version " + to_string(header.version)
+                        + " instead of " + to_string(VERSION) + ": "
+                        + filename);
+    if (boost::filesystem::file_size(filename) != sizeof(header) + header.length)
+        throw IO_Error("wrong length of setup file: " + filename);
+
+    // read directly into the stream buffer
+    os.reset_write_head();
+    auto data = os.append(header.length);
+    file.read((char*) data, header.length);
+    if (size_t(file.gcount()) != header.length)
+        throw IO_Error("cannot read setup file: " + filename);
+
+    unsigned char hash[crypto_generichash_BYTES];
+    crypto_generichash(hash, sizeof(hash), data, header.length, NULL, 0);
+    if (memcmp(hash, header.hash, sizeof(hash)))
+        throw IO_Error("hash mismatch in setup file: " + filename);
+}
+
+void SetupFile::write(const octetStream& os, const string& filename)
+{
+    SetupFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.tag, tag, sizeof(tag));
+    header.version = VERSION;
+    header.length = os.get_length();
+    crypto_generichash(header.hash, sizeof(header.hash), os.get_data(),
+            os.get_length(), NULL, 0);
+
+    // avoid other processes reading a partial file
+    string tmp = filename + ".tmp";
+    ofstream file(tmp, ios::binary);
+    file.write((char*) &header, sizeof(header));
+    file.write((char*) os.get_data(), os.get_length());
+    file.close();
+    if (not file.good())
+        throw file_error("cannot write to " + tmp);
+    boost::filesystem::rename(tmp, filename);
+}
@@ -0,0 +1,30 @@
+/*
+ * SetupFile.h
+ *
+ */
+
+#ifndef FHEOFFLINE_SETUPFILE_H_
+#define FHEOFFLINE_SETUPFILE_H_
+
+#include "Tools/octetStream.h"
+
+#include <string>
+using namespace std;
+
+/*
+ * Versioned on-disk cache for parameters and key material.
+ * The content is read directly into the stream buffer and checked
+ * against a hash in the header, so stale or corrupted files are
+ * rejected and the material is regenerated.
+ */
+class SetupFile
+{
+public:
+    // increase when changing the serialization of setup classes
+    static const int VERSION = 1;
+
+    static void read(octetStream& os, const string& filename);
+    static void write(const octetStream& os, const string& filename);
+};
+
+#endif /* FHEOFFLINE_SETUPFILE_H_ */
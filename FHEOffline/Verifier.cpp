@@ -5,16 +5,43 @@
 
 template <class FD>
 Verifier<FD>::Verifier(Proof& proof, const FD& FieldD) :
+    workers(ProofWorkers::shared()),
+    z(workers.n_threads()), t(workers.n_threads()),
+    d(workers.n_threads(), Ciphertext(proof.pk->get_params())),
+    ciphertext_buffers(workers.n_threads(),
+        Ciphertext(proof.pk->get_params())),
+    rcs(workers.n_threads(), Random_Coins(proof.pk->get_params())),
     P(proof), FieldD(FieldD)
 {
 #ifdef LESS_ALLOC_MORE_MEM
-  z.resize(proof.phim);
-  z.allocate_slots(bigint(1) << proof.B_plain_length);
-  t.resize(3, proof.phim);
-  t.allocate_slots(bigint(1) << proof.B_rand_length);
+  for (auto& x : z)
+    {
+      x.resize(proof.phim);
+      x.allocate_slots(bigint(1) << proof.B_plain_length);
+    }
+  for (auto& x : t)
+    {
+      x.resize(3, proof.phim);
+      x.allocate_slots(bigint(1) << proof.B_rand_length);
+    }
 #endif
 }
 
+template <class FD>
+size_t Verifier<FD>::report_size(ReportType type)
+{
+  size_t res = 0;
+  for (auto& x : z)
+    res += x.report_size(type);
+  for (auto& x : t)
+    res += x.report_size(type);
+  for (auto& x : d)
+    res += x.report_size(type);
+  for (auto& x : ciphertext_buffers)
+    res += x.report_size(type);
+  return res;
+}
+
 
 template <class T, class FD, class S>
 bool Check_Decoding(const Plaintext<T,FD,S>& AE,bool Diag)
@@ -67,45 +94,75 @@ void Verifier<FD>::Stage_2(
                           octetStream& cleartexts,
                           const FHE_PK& pk)
 {
-  unsigned int i, V;
+  unsigned int V;
 
   c.unpack(ciphertexts, pk);
   if (c.size() != P.U)
     throw length_error("number of received ciphertexts incorrect");
 
-  // Now check the encryptions are correct
-  Ciphertext d1(pk.get_params()), d2(pk.get_params());
-  Random_Coins rc(pk.get_params());
   ciphertexts.get(V);
   if (V != P.V)
     throw length_error("number of received commitments incorrect");
   cleartexts.get(V);
   if (V != P.V)
     throw length_error("number of received cleartexts incorrect");
-  for (i=0; i<V; i++)
+
+  // unpacking is sequential, the checks are independent,
+  // so process one entry per thread at a time
+  int res = 0;
+  size_t n_threads = workers.n_threads();
+  for (size_t start = 0; start < V and res == 0; start += n_threads)
     {
-      z.unpack(cleartexts);
-      t.unpack(cleartexts);
-      if (!P.check_bounds(z, t, i))
-        throw runtime_error("preimage out of bounds");
-      d1.unpack(ciphertexts);
-      P.apply_challenge(i, d1, c, pk);
-      rc.assign(t[0], t[1], t[2]);
-      pk.encrypt(d2,z,rc);
-      if (!(d1 == d2))
+      size_t n = min(n_threads, V - start);
+      for (size_t j = 0; j < n; j++)
+        {
+          z[j].unpack(cleartexts);
+          t[j].unpack(cleartexts);
+          d[j].unpack(ciphertexts);
+        }
+
+      // Now check the encryptions are correct
+      res = workers.run(n, [&](size_t begin, size_t end, int thread_num) -> int
         {
+          auto& d2 = ciphertext_buffers[thread_num];
+          auto& rc = rcs[thread_num];
+          for (size_t j = begin; j < end; j++)
+            {
+              size_t i = start + j;
+              if (!P.check_bounds(z[j], t[j], i))
+                return 1;
+              P.apply_challenge(i, d[j], c, pk);
+              rc.assign(t[j][0], t[j][1], t[j][2]);
+              pk.encrypt(d2,z[j],rc);
+              if (!(d[j] == d2))
+                {
 #ifdef VERBOSE
-          cout << "Fail Check 6 " << i << endl;
+                  cout << "Fail Check 6 " << i << endl;
 #endif
-          throw runtime_error("ciphertexts don't match");
-        }
-      if (!Check_Decoding(z,P.get_diagonal(),FieldD))
-         {
+                  return 2;
+                }
+              if (!Check_Decoding(z[j],P.get_diagonal(),FieldD))
+                {
 #ifdef VERBOSE
-          cout << "\tCheck : " << i << endl;
+                  cout << "\tCheck : " << i << endl;
 #endif
-           throw runtime_error("cleartext isn't diagonal");
-         }
+                  return 3;
+                }
+            }
+          return 0;
+        });
+    }
+
+  switch (res)
+    {
+    case 0:
+      break;
+    case 1:
+      throw runtime_error("preimage out of bounds");
+    case 2:
+      throw runtime_error("ciphertexts don't match");
+    default:
+      throw runtime_error("cleartext isn't diagonal");
     }
 }
 
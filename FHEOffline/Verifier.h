@@ -2,6 +2,7 @@
 #define _Verifier
 
 #include "Proof.h"
+#include "ProofJob.h"
 
 template <class FD>
 bool Check_Decoding(const vector<Proof::bound_type>& AE, bool Diag, FD& FieldD);
@@ -10,8 +11,13 @@ bool Check_Decoding(const vector<Proof::bound_type>& AE, bool Diag, FD& FieldD);
 template <class FD>
 class Verifier
 {
-  AddableVector<typename Proof::bound_type> z;
-  AddableMatrix<Int_Random_Coins::value_type::value_type> t;
+  /* Per-thread state for splitting the proof across workers */
+  ProofWorkers& workers;
+  vector<AddableVector<typename Proof::bound_type>> z;
+  vector<AddableMatrix<Int_Random_Coins::value_type::value_type>> t;
+  vector<Ciphertext> d;
+  vector<Ciphertext> ciphertext_buffers;
+  vector<Random_Coins> rcs;
 
   Proof& P;
   const FD& FieldD;
@@ -30,7 +36,7 @@ public:
   void NIZKPoK(AddableVector<Ciphertext>& c,octetStream& ciphertexts,octetStream& cleartexts,
                const FHE_PK& pk);
 
-  size_t report_size(ReportType type) { return z.report_size(type) + t.report_size(type); }
+  size_t report_size(ReportType type);
 };
 
 #endif
@@ -34,6 +34,11 @@ class Program
     // Memory size used directly
     unsigned max_mem[MAX_REG_TYPE];
 
+    string name;
+
+    // source locations for profiling
+    vector<string> locations;
+
     void compute_constants();
 
     public:
@@ -59,6 +59,10 @@ void Program::parse_file(const string& filename)
     if (s.bad() or s.fail())
         throw runtime_error("Cannot open " + filename);
     parse(s);
+
+    name = filename.substr(filename.rfind('/') + 1);
+    name = name.substr(0, name.rfind(".bc"));
+    locations = Profiler::read_locations(filename, p.size());
 }
 
 inline
@@ -113,6 +117,9 @@ BreakType Program::execute(Processor<T>& Proc, U& dynamic_memory,
         Proc.stats[p[Proc.PC].get_opcode()]++;
 #endif
         auto& instruction = p[Proc.PC++];
+        bool profile = Proc.profiler.tick();
+        if (profile)
+            Proc.profiler.start();
         switch (instruction.get_opcode())
         {
 #define X(NAME, CODE) case NAME: CODE; break;
@@ -121,6 +128,9 @@ BreakType Program::execute(Processor<T>& Proc, U& dynamic_memory,
         default:
             fallback_code(instruction, processor);
         }
+        if (profile)
+            Proc.profiler.stop(name, locations, &instruction - &p[0],
+                    instruction.get_opcode());
         time++;
 #ifdef DEBUG_COMPLEXITY
         cout << T::part_type::name() << " complexity at " << time << ": " <<
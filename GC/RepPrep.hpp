@@ -51,7 +51,7 @@ void RepPrep<T>::buffer_triples()
     assert(protocol != 0);
     auto MC = ShareThread<T>::s().new_mc({});
     ThreadQueues* queues = 0;
-    if (BaseMachine::has_singleton() and BaseMachine::thread_num == 0)
+    if (BaseMachine::has_singleton() and BaseMachine::is_main_thread())
         queues = &BaseMachine::s().queues;
     shuffle_triple_generation(this->triples, protocol->P, *MC, 64, queues);
     MC->Check(protocol->P);
@@ -77,26 +77,29 @@ void RepPrep<T>::buffer_inputs(int player)
     assert(this->protocol != 0);
     auto& protocol = *this->protocol;
     this->inputs.resize(protocol.P.num_players());
+    size_t n = OnlineOptions::singleton.batch_size;
     if (player == protocol.P.my_num())
     {
-        for (int i = 0; i < OnlineOptions::singleton.batch_size; i++)
+        vector<T> shares(n);
+        ReplicatedBase::randomize_many(shares.data(), n, protocol.shared_prngs);
+        for (auto& share : shares)
         {
             InputTuple<T> tuple;
+            tuple.share = share;
             for (int j = 0; j < 2; j++)
-            {
-                tuple.share[j].randomize(protocol.shared_prngs[j]);
                 tuple.value += tuple.share[j];
-            }
             this->inputs[player].push_back(tuple);
         }
     }
     else
     {
-        for (int i = 0; i < OnlineOptions::singleton.batch_size; i++)
+        int j = protocol.P.get_offset(player) - 1;
+        vector<typename T::value_type> shares(n);
+        T::value_type::randomize_many(shares.data(), n, protocol.shared_prngs[j]);
+        for (auto& share : shares)
         {
             this->inputs[player].push_back({});
-            int j = protocol.P.get_offset(player) - 1;
-            this->inputs[player].back().share[j].randomize(protocol.shared_prngs[j]);
+            this->inputs[player].back().share[j] = share;
         }
     }
 }
@@ -40,6 +40,8 @@ public:
 
     static const bool symmetric = V::symmetric;
 
+    static const bool bitwise_xor = true;
+
     static bool real_shares(const Player& P)
     {
         return V::real_shares(P);
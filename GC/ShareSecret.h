@@ -48,6 +48,9 @@ public:
     static const bool actual_inputs = true;
     static const bool symmetric = true;
 
+    // XOR of registers is XOR of their memory representation
+    static const bool bitwise_xor = false;
+
     static bool real_shares(const Player&) { return true; }
 
     static ShareThread<U>& get_party()
@@ -133,6 +136,7 @@ public:
     static const bool variable_players = false;
     static const bool needs_ot = false;
     static const bool has_mac = false;
+    static const bool bitwise_xor = true;
     static const bool randoms_for_opens = false;
 
     static string type_string() { return "replicated secret"; }
@@ -10,6 +10,7 @@
 #include "GC/ShareParty.h"
 #include "BitPrepFiles.h"
 #include "Math/Setup.h"
+#include "Tools/avx_memcpy.h"
 
 #include "Processor/Data_Files.hpp"
 
@@ -93,7 +94,7 @@ void ShareThread<T>::and_(Processor<T>& processor,
     auto& protocol = this->protocol;
     processor.check_args(args, 4);
     protocol->init_mul();
-    T x_ext, y_ext;
+    T x_ext, y_ext, y_full;
     int total_bits = 0;
     for (size_t i = 0; i < args.size(); i += 4)
     {
@@ -101,6 +102,10 @@ void ShareThread<T>::and_(Processor<T>& processor,
         total_bits += n_bits;
         int left = args[i + 2];
         int right = args[i + 3];
+        // the same extension for all full registers
+        bool full_repeat = repeat and T::bitwise_xor;
+        if (full_repeat)
+            processor.S[right].extend_bit(y_full, T::default_length);
         for (int j = 0; j < DIV_CEIL(n_bits, T::default_length); j++)
         {
             int n = min(T::default_length, n_bits - j * T::default_length);
@@ -111,6 +116,12 @@ void ShareThread<T>::and_(Processor<T>& processor,
                 continue;
             }
 
+            if (full_repeat and n == T::default_length)
+            {
+                protocol->prepare_mult(processor.S[left + j], y_full, n, true);
+                continue;
+            }
+
             processor.S[left + j].mask(x_ext, n);
             if (repeat)
                 processor.S[right].extend_bit(y_ext, n);
@@ -216,12 +227,32 @@ void ShareThread<T>::xors(Processor<T>& processor, const vector<int>& args)
         if (n_bits == 1)
             processor.S[out].xor_(1, processor.S[left], processor.S[right]);
         else
-            for (int j = 0; j < DIV_CEIL(n_bits, T::default_length); j++)
+        {
+            int n_units = DIV_CEIL(n_bits, T::default_length);
+            int j = 0;
+            if (T::bitwise_xor)
+            {
+                // full registers in wide words
+                int n_full = n_bits / T::default_length;
+                auto separate = [n_full](int a, int b)
+                {
+                    return a == b or a + n_full <= b or b + n_full <= a;
+                };
+                if (n_full > 1 and separate(out, left)
+                        and separate(out, right))
+                {
+                    avx_xor(&processor.S[out], &processor.S[left],
+                            &processor.S[right], n_full * sizeof(T));
+                    j = n_full;
+                }
+            }
+            for (; j < n_units; j++)
             {
                 int n = min(T::default_length, n_bits - j * T::default_length);
                 processor.S[out + j].xor_(n, processor.S[left + j],
                         processor.S[right + j]);
             }
+        }
     }
 }
 
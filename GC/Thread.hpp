@@ -61,6 +61,7 @@ void Thread<T>::run()
         P = new CryptoPlayer(N, id);
     else
         P = new PlainPlayer(N, id);
+    processor.profiler.set_player(*P);
     processor.open_input_file(N.my_num(), thread_num,
             master.opts.cmd_private_input_file);
     processor.setup_redirection(P->my_num(), thread_num, master.opts,
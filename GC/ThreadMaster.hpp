@@ -112,15 +112,18 @@ void ThreadMaster<T>::run_with_error()
 
     NamedCommStats stats = P->total_comm();
     ExecutionStats exe_stats;
+    Profiler profiler;
     for (auto thread : threads)
     {
         stats += thread->P->total_comm();
         exe_stats += thread->processor.stats;
+        profiler.add(thread->processor.profiler);
         delete thread;
     }
 
     if (not exe_stats.empty())
         exe_stats.print();
+    profiler.write(P->my_num());
     stats.print();
 
     machine.print_timers();
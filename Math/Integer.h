@@ -99,6 +99,7 @@ public:
 
   void randomize(PRNG& G);
   void almost_randomize(PRNG& G) { randomize(G); }
+  static void randomize_many(IntBase* res, size_t n, PRNG& G);
 
   void output(ostream& s,bool human) const;
   void input(istream& s,bool human);
@@ -170,6 +171,24 @@ inline void IntBase<long>::randomize(PRNG& G)
   a = G.get_word();
 }
 
+template<class T>
+inline void IntBase<T>::randomize_many(IntBase* res, size_t n, PRNG& G)
+{
+  for (size_t i = 0; i < n; i++)
+    res[i].randomize(G);
+}
+
+template<>
+inline void IntBase<long>::randomize_many(IntBase* res, size_t n, PRNG& G)
+{
+  // same stream as calling randomize() n times
+  size_t max_n = INT_MAX / N_BYTES;
+  for (size_t i = 0; i < n; i += max_n)
+    G.get_octets((octet*)(res + i), min(n - i, max_n) * N_BYTES);
+  for (size_t i = 0; i < n; i++)
+    res[i].a = le64toh(res[i].a);
+}
+
 template<>
 inline void IntBase<bool>::randomize(PRNG& G)
 {
@@ -42,6 +42,13 @@ public:
     void normalize() {}
 
     void randomize_part(PRNG&, int) { throw not_implemented(); }
+
+    template<class T>
+    static void randomize_many(T* res, size_t n, PRNG& G)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i].randomize(G);
+    }
 };
 
 #endif /* MATH_VALUEINTERFACE_H_ */
@@ -178,6 +178,7 @@ public:
 	 */
 	void randomize(PRNG& G, int n = -1);
 	void randomize_part(PRNG& G, int n);
+	static void randomize_many(Z2* res, size_t n, PRNG& G);
 	void almost_randomize(PRNG& G) { randomize(G); }
 
 	void force_to_bit() { throw runtime_error("impossible"); }
@@ -441,6 +442,26 @@ void Z2<K>::randomize(PRNG& G, int n)
 	normalize();
 }
 
+template<int K>
+void Z2<K>::randomize_many(Z2* res, size_t n, PRNG& G)
+{
+	// same stream as calling randomize() n times
+	if (sizeof(Z2) != N_BYTES)
+	{
+		for (size_t i = 0; i < n; i++)
+			res[i].randomize(G);
+		return;
+	}
+
+	size_t max_n = INT_MAX / N_BYTES;
+	for (size_t i = 0; i < n; i += max_n)
+		G.get_octets((octet*)(res + i), min(n - i, max_n) * N_BYTES);
+
+	if (K % N_LIMB_BITS)
+		for (size_t i = 0; i < n; i++)
+			res[i].normalize();
+}
+
 template<int K>
 void Z2<K>::randomize_part(PRNG& G, int n)
 {
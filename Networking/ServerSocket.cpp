@@ -236,14 +236,26 @@ void AnonymousServerSocket::process_client(const string& client_id)
 }
 
 int AnonymousServerSocket::get_connection_socket(string& client_id)
+{
+  int res = get_connection_socket(client_id, CONNECTION_TIMEOUT);
+  if (res < 0)
+      exit_error("timed out while waiting for client");
+  return res;
+}
+
+int AnonymousServerSocket::get_connection_socket(string& client_id,
+    int timeout)
 {
   data_signal.lock();
 
   while (client_connection_queue.empty())
   {
-      int res = data_signal.wait(CONNECTION_TIMEOUT);
+      int res = data_signal.wait(timeout);
       if (res == ETIMEDOUT)
-          exit_error("timed out while waiting for client");
+        {
+          data_signal.unlock();
+          return -1;
+        }
       else if (res)
           throw runtime_error("waiting error");
   }
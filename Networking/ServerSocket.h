@@ -71,6 +71,8 @@ public:
 
     // Get socket and id for the last client who connected
     int get_connection_socket(string& client_id);
+    // Same but returns -1 if no client connects in time (in seconds)
+    int get_connection_socket(string& client_id, int timeout);
 
     void remove_client(const string& client_id);
 };
@@ -17,6 +17,7 @@ using namespace std;
 
 BaseMachine* BaseMachine::singleton = 0;
 thread_local int BaseMachine::thread_num;
+thread_local bool BaseMachine::background_thread;
 thread_local OnDemandOTTripleSetup BaseMachine::ot_setup;
 
 void print_usage(ostream& o, const char* name, size_t capacity)
@@ -41,6 +41,8 @@ protected:
 
 public:
     static thread_local int thread_num;
+    // threads that only produce preprocessing
+    static thread_local bool background_thread;
 
     string progname;
     int nthreads;
@@ -54,6 +56,8 @@ public:
 
     static BaseMachine& s();
     static bool has_singleton() { return singleton != 0; }
+    // the first online thread, which distributes work to the others
+    static bool is_main_thread() { return thread_num == 0 and not background_thread; }
     static bool has_program();
 
     static string memory_filename(const string& type_short, int my_number);
@@ -0,0 +1,54 @@
+/*
+ * ChunkPool.cpp
+ *
+ */
+
+#include "ChunkPool.h"
+#include "Tools/Exceptions.h"
+
+void ChunkPool::init(long n_chunks, long n_owners)
+{
+    if (n_chunks < 0 or n_owners <= 0)
+        throw runtime_error(
+                "invalid chunk distribution: " + to_string(n_chunks)
+                        + " chunks to " + to_string(n_owners) + " threads");
+
+    lock_guard<mutex> _(lock);
+    ranges.resize(n_owners);
+    for (long i = 0; i < n_owners; i++)
+        ranges[i] = {n_chunks * i / n_owners, n_chunks * (i + 1) / n_owners};
+}
+
+ChunkPool::Range ChunkPool::next(long owner)
+{
+    lock_guard<mutex> _(lock);
+    if (owner < 0 or size_t(owner) >= ranges.size())
+        throw overflow("invalid chunk owner", owner, ranges.size());
+
+    auto& own = ranges[owner];
+    if (own.size() <= 0)
+    {
+        auto victim = &ranges[0];
+        for (auto& range : ranges)
+            if (range.size() > victim->size())
+                victim = &range;
+
+        if (victim->size() <= 0)
+            return {0, 0};
+
+        long middle = victim->begin + victim->size() / 2;
+        own = {middle, victim->end};
+        victim->end = middle;
+    }
+
+    long n = max(1l, own.size() / 2);
+    Range res = {own.begin, own.begin + n};
+    own.begin += n;
+    return res;
+}
+
+ChunkPool& ChunkPools::operator[](int id)
+{
+    lock_guard<mutex> _(lock);
+    return pools[id];
+}
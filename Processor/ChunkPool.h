@@ -0,0 +1,55 @@
+/*
+ * ChunkPool.h
+ *
+ */
+
+#ifndef PROCESSOR_CHUNKPOOL_H_
+#define PROCESSOR_CHUNKPOOL_H_
+
+#include <vector>
+#include <map>
+#include <mutex>
+using namespace std;
+
+/**
+ * Chunks of a multithreaded loop for distribution at runtime.
+ * Every thread starts with a contiguous range of chunks
+ * and steals the upper half of the largest remaining range
+ * once its own is exhausted. Chunks are granted in batches
+ * of half the remaining own range to save communication.
+ * Only the first party uses this, the others follow its decisions.
+ */
+class ChunkPool
+{
+public:
+    struct Range
+    {
+        long begin, end;
+
+        long size() const
+        {
+            return end - begin;
+        }
+    };
+
+private:
+    vector<Range> ranges;
+    mutex lock;
+
+public:
+    void init(long n_chunks, long n_owners);
+
+    // returns an empty range if all chunks are taken
+    Range next(long owner);
+};
+
+class ChunkPools
+{
+    map<int, ChunkPool> pools;
+    mutex lock;
+
+public:
+    ChunkPool& operator[](int id);
+};
+
+#endif /* PROCESSOR_CHUNKPOOL_H_ */
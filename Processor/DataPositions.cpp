@@ -32,6 +32,80 @@ void DataPositions::set_num_players(int num_players)
   inputs.resize(num_players, {});
 }
 
+void DataPositions::pack(octetStream& os) const
+{
+  for (auto& x : files)
+    for (auto& y : x)
+      os.store_int(y, 8);
+  os.store(inputs.size());
+  for (auto& x : inputs)
+    for (auto& y : x)
+      os.store_int(y, 8);
+  for (auto& x : extended)
+    {
+      os.store(x.size());
+      for (auto& y : x)
+        {
+          os.append((const octet*) &y.first, sizeof(y.first));
+          os.store_int(y.second, 8);
+        }
+    }
+  os.store(edabits.size());
+  for (auto& x : edabits)
+    {
+      os.store_int(x.first.first, 1);
+      os.store(x.first.second);
+      os.store_int(x.second, 8);
+    }
+  os.store(matmuls.size());
+  for (auto& x : matmuls)
+    {
+      for (auto& y : x.first)
+        os.store(y);
+      os.store_int(x.second, 8);
+    }
+}
+
+void DataPositions::unpack(octetStream& os)
+{
+  for (auto& x : files)
+    for (auto& y : x)
+      y = os.get_int(8);
+  inputs.resize(os.get_int(8));
+  for (auto& x : inputs)
+    for (auto& y : x)
+      y = os.get_int(8);
+  for (auto& x : extended)
+    {
+      x.clear();
+      size_t n = os.get_int(8);
+      for (size_t i = 0; i < n; i++)
+        {
+          int tag[4];
+          os.consume((octet*) tag, sizeof(tag));
+          x[tag] = os.get_int(8);
+        }
+    }
+  edabits.clear();
+  size_t n = os.get_int(8);
+  for (size_t i = 0; i < n; i++)
+    {
+      bool strict = os.get_int(1);
+      int n_bits;
+      os.get(n_bits);
+      edabits[{strict, n_bits}] = os.get_int(8);
+    }
+  matmuls.clear();
+  n = os.get_int(8);
+  for (size_t i = 0; i < n; i++)
+    {
+      array<int, 3> dims;
+      for (auto& y : dims)
+        os.get(y);
+      matmuls[dims] = os.get_int(8);
+    }
+}
+
 void DataPositions::count(DataFieldType type, DataTag tag, int n)
 {
   extended[type][tag] += n;
@@ -42,6 +116,11 @@ void DataPositions::count_edabit(bool strict, int n_bits)
   edabits[{strict, n_bits}]++;
 }
 
+void DataPositions::count_prefetched(bool strict, int n_bits, bool waited)
+{
+  prefetched[{strict, n_bits}][waited]++;
+}
+
 void DataPositions::increase(const DataPositions& delta)
 {
   inputs.resize(max(inputs.size(), delta.inputs.size()), {});
@@ -59,6 +138,9 @@ void DataPositions::increase(const DataPositions& delta)
     }
   for (auto it = delta.edabits.begin(); it != delta.edabits.end(); it++)
     edabits[it->first] += it->second;
+  for (auto& x : delta.prefetched)
+    for (int i = 0; i < 2; i++)
+      prefetched[x.first][i] += x.second[i];
 }
 
 DataPositions& DataPositions::operator-=(const DataPositions& delta)
@@ -79,6 +161,9 @@ DataPositions& DataPositions::operator-=(const DataPositions& delta)
     }
   for (auto it = delta.edabits.begin(); it != delta.edabits.end(); it++)
     edabits[it->first] -= it->second;
+  for (auto& x : delta.prefetched)
+    for (int i = 0; i < 2; i++)
+      prefetched[x.first][i] -= x.second[i];
   return *this;
 }
 
@@ -148,6 +233,23 @@ void DataPositions::print_cost() const
           cerr << endl;
         }
     }
+
+  if (not prefetched.empty())
+    cerr << "  Background batches (ready/waited for)" << endl;
+  for (auto& x : prefetched)
+    {
+      if (print_verbose)
+          cerr << setw(13) << "";
+      cerr << "    " << setw(10) << x.second[0] << " " << setw(10)
+          << x.second[1] << " ";
+      if (x.first.second)
+        cerr << "edaBits of length " << x.first.second;
+      else
+        cerr << "daBits";
+      if (x.first.first)
+        cerr << " (strict)";
+      cerr << endl;
+    }
 }
 
 void DataPositions::process_line(long long items_used, const char* name,
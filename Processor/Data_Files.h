@@ -68,6 +68,8 @@ public:
   array<map<DataTag, long long>, N_DATA_FIELD_TYPE> extended;
   map<pair<bool, int>, long long> edabits;
   map<array<int, 3>, long long> matmuls;
+  // background batches ready in time or waited for, length 0 for daBits
+  map<pair<bool, int>, array<long long, 2>> prefetched;
 
   DataPositions(int num_players = 0);
   DataPositions(const Player& P) : DataPositions(P.num_players()) {}
@@ -75,10 +77,14 @@ public:
 
   void reset();
   void set_num_players(int num_players);
+
+  void pack(octetStream& os) const;
+  void unpack(octetStream& os);
   int num_players() { return inputs.size(); }
 
   void count(DataFieldType type, DataTag tag, int n = 1);
   void count_edabit(bool strict, int n_bits);
+  void count_prefetched(bool strict, int n_bits, bool waited);
 
   void increase(const DataPositions& delta);
   DataPositions& operator-=(const DataPositions& delta);
@@ -196,6 +202,7 @@ public:
   virtual Preprocessing<typename T::part_type>& get_part() { throw runtime_error("no part"); }
 
   virtual int minimum_batch() { return 0; }
+  virtual int full_batch() { return minimum_batch(); }
 };
 
 template<class T>
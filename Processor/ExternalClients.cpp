@@ -51,11 +51,37 @@ int ExternalClients::get_client_connection(int portnum_base)
     cerr << "Thread " << this_thread::get_id() << " didn't find server." << endl; 
     throw runtime_error("No connection on port " + to_string(portnum_base));
   }
-  int client_id, socket;
   string client;
-  socket = client_connection_servers[portnum_base]->get_connection_socket(
+  int socket = client_connection_servers[portnum_base]->get_connection_socket(
       client);
-  client_id = stoi(client);
+  return add_client(portnum_base, socket, client);
+}
+
+int ExternalClients::get_client_connection(int portnum_base, int timeout)
+{
+  AnonymousServerSocket* server;
+  {
+    ScopeLock _(lock);
+    auto it = client_connection_servers.find(portnum_base);
+    if (it == client_connection_servers.end())
+      throw runtime_error("No connection on port " + to_string(portnum_base));
+    server = it->second;
+  }
+
+  // don't block other threads while waiting
+  string client;
+  int socket = server->get_connection_socket(client, timeout);
+  if (socket < 0)
+    return -1;
+
+  ScopeLock _(lock);
+  return add_client(portnum_base, socket, client);
+}
+
+int ExternalClients::add_client(int portnum_base, int socket,
+    const string& client)
+{
+  int client_id = stoi(client);
   if (ctx == 0)
     ctx = new client_ctx("P" + to_string(get_party_num()));
   external_client_sockets[client_id] = new client_socket(io_service, *ctx, socket,
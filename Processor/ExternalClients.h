@@ -36,6 +36,8 @@ class ExternalClients
 
   Lock lock;
 
+  int add_client(int portnum_base, int socket, const string& client);
+
   public:
 
   ExternalClients(int party_num);
@@ -44,6 +46,8 @@ class ExternalClients
   void start_listening(int portnum_base);
 
   int get_client_connection(int portnum_base);
+  // returns -1 if no client connects within the timeout (in seconds)
+  int get_client_connection(int portnum_base, int timeout);
   int init_client_connection(const string& host, int portnum, int my_client_id);
 
   void close_connection(int client_id);
@@ -76,6 +76,8 @@ enum
     CMDLINEARG = 0xEB,
     CALL_TAPE = 0xEC,
     CALL_ARG = 0xED,
+    INITCHUNKS = 0xEE,
+    NEXTCHUNK = 0xEF,
     // Addition
     ADDC = 0x20,
     ADDS = 0x21,
@@ -214,6 +216,8 @@ enum
     PRINTFLOATPLAIN = 0xBC,
     WRITEFILESHARE = 0xBD,
     READFILESHARE = 0xBE,
+    WRITETABLESHARE = 0xC2,
+    READTABLESHARE = 0xC3,
     CONDPRINTSTR = 0xBF,
     PRINTFLOATPREC = 0xE0,
     CONDPRINTPLAIN = 0xE1,
@@ -344,6 +348,7 @@ struct TempVars {
 class BaseInstruction
 {
   friend class Program;
+  friend class TapeCache;
   template<class T> friend class RepRingOnlyEdabitPrep;
 
 protected:
@@ -367,6 +372,8 @@ public:
   // Reads a single instruction from the istream
   void parse(istream& s, int inst_pos);
   void parse_operands(istream& s, int pos, int file_pos);
+  // Checks the requirements of REQBL, GREQBL, and ACTIVE
+  void check_requirement() const;
 
   bool is_gf2n_instruction() const { return ((opcode&0x100)!=0); }
   virtual int get_reg_type() const;
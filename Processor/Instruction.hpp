@@ -208,6 +208,8 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case GINPUTMASK:
       case SECSHUFFLE:
       case GSECSHUFFLE:
+      case INITCHUNKS:
+      case NEXTCHUNK:
         get_ints(r, s, 2);
         n = get_int(s);
         break;
@@ -339,6 +341,22 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
         get_vector(num_var_args, start, s);
         break;
 
+      // named table, input is opcode num_args, name (16 bytes),
+      //   start_posn (read), [end_posn (write),] var1, var2, ...
+      case READTABLESHARE:
+      case WRITETABLESHARE:
+        num_var_args = get_int(s) - 2 - (opcode == READTABLESHARE);
+        {
+          char name[16];
+          s.read(name, 16);
+          str.assign(name, strnlen(name, 16));
+        }
+        r[0] = get_int(s);
+        if (opcode == READTABLESHARE)
+          r[1] = get_int(s);
+        get_vector(num_var_args, start, s);
+        break;
+
       // read from external client, input is : opcode num_args, client_id, var1, var2 ...
       case READSOCKETC:
       case READSOCKETS:
@@ -420,21 +438,10 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
         n = get_long(s);
         break;
       case REQBL:
-        n = get_int(s);
-        BaseMachine::s().reqbl(n);
-        break;
       case GREQBL:
-        n = get_int(s);
-        if (n > 0 && gf2n::degree() < int(n))
-          {
-            stringstream ss;
-            ss << "Tape requires prime of bit length " << n << endl;
-            throw Processor_Error(ss.str());
-          }
-        break;
       case ACTIVE:
         n = get_int(s);
-        BaseMachine::s().active(n);
+        check_requirement();
         break;
       case XORM:
       case ANDM:
@@ -512,6 +519,28 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
   }
 }
 
+inline
+void BaseInstruction::check_requirement() const
+{
+  switch (opcode)
+  {
+    case REQBL:
+      BaseMachine::s().reqbl(n);
+      break;
+    case GREQBL:
+      if (n > 0 && gf2n::degree() < int(n))
+        {
+          stringstream ss;
+          ss << "Tape requires prime of bit length " << n << endl;
+          throw Processor_Error(ss.str());
+        }
+      break;
+    case ACTIVE:
+      BaseMachine::s().active(n);
+      break;
+  }
+}
+
 inline
 bool Instruction::get_offline_data_usage(DataPositions& usage)
 {
@@ -592,6 +621,8 @@ int BaseInstruction::get_reg_type() const
     case GENSECSHUFFLE:
     case CMDLINEARG:
     case CALL_TAPE:
+    case INITCHUNKS:
+    case NEXTCHUNK:
       return INT;
     case PREP:
     case GPREP:
@@ -1198,10 +1229,10 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case CHECK:
         {
           CheckJob job;
-          if (BaseMachine::thread_num == 0)
+          if (BaseMachine::is_main_thread())
             BaseMachine::s().queues.distribute(job, 0);
           Proc.check();
-          if (BaseMachine::thread_num == 0)
+          if (BaseMachine::is_main_thread())
             BaseMachine::s().queues.wrap_up(job);
           return;
         }
@@ -1285,6 +1316,13 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case CALL_TAPE:
         Proc.call_tape(r[0], Proc.read_Ci(r[1]), start);
         break;
+      case INITCHUNKS:
+        Proc.machine.chunk_pools[n].init(Proc.read_Ci(r[0]),
+            Proc.read_Ci(r[1]));
+        break;
+      case NEXTCHUNK:
+        Proc.write_Ci(r[0], Proc.next_chunk(n, Proc.read_Ci(r[1])));
+        break;
       case CRASH:
         if (Proc.read_Ci(r[0]))
           throw crash_requested();
@@ -1381,6 +1419,13 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         // Read shares from file system
         Proc.read_shares_from_file(Proc.read_Ci(r[0]), r[1], start, size);
         return;
+      case WRITETABLESHARE:
+        Proc.write_shares_to_table(str, Proc.read_Ci(r[0]), start, size);
+        return;
+      case READTABLESHARE:
+        Proc.read_shares_from_table(str, Proc.read_Ci(r[0]), r[1], start,
+            size);
+        return;
       case PUBINPUT:
         Proc.get_Cp_ref(r[0]) = Proc.template
             get_input<IntInput<typename sint::clear>>(
@@ -1443,6 +1488,8 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
 template<class sint, class sgf2n>
 void Program::execute(Processor<sint, sgf2n>& Proc) const
 {
+  load();
+
   if (OnlineOptions::singleton.has_option("throw_exceptions"))
     execute_with_errors(Proc);
   else
@@ -1463,6 +1510,7 @@ void Program::execute(Processor<sint, sgf2n>& Proc) const
 template<class sint, class sgf2n>
 void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
 {
+  load();
   unsigned int size = p.size();
   Proc.PC=0;
 
@@ -1498,6 +1546,10 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
           cerr << instruction << endl;
 #endif
 
+      bool profile = Proc.profiler.tick();
+      if (profile)
+        Proc.profiler.start();
+
       Proc.PC++;
 
       switch(instruction.get_opcode())
@@ -1521,6 +1573,10 @@ void Program::execute_with_errors(Processor<sint, sgf2n>& Proc) const
           instruction.execute(Proc);
         }
 
+      if (profile)
+        Proc.profiler.stop(name, locations, &instruction - &p[0],
+            instruction.get_opcode());
+
 #if defined(COUNT_INSTRUCTIONS) and defined(TIME_INSTRUCTIONS)
       Proc.stats[p[PC].get_opcode()] += timer.elapsed() * 1e9;
 #endif
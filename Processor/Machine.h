@@ -14,6 +14,9 @@
 #include "Processor/Online-Thread.h"
 #include "Processor/ThreadJob.h"
 #include "Processor/ExternalClients.h"
+#include "Processor/ShareStore.h"
+#include "Processor/Profiler.h"
+#include "Processor/ChunkPool.h"
 
 #include "Processor/FunctionArgument.h"
 
@@ -24,6 +27,7 @@
 
 #include "Protocols/SecureShuffle.h"
 #include "Protocols/NoShare.h"
+#include "Protocols/PrepService.h"
 
 #include <vector>
 #include <map>
@@ -56,6 +60,9 @@ class Machine : public BaseMachine
 
   void prepare(const string& progname_str);
 
+  void run_prep_worker(PrepService<sint>& service,
+      const typename PrepService<sint>::key_type& key, int worker);
+
   void suggest_optimizations();
 
   public:
@@ -65,6 +72,12 @@ class Machine : public BaseMachine
   Memory<Integer> Mi;
   GC::Memories<typename sint::bit_type> bit_memories;
 
+  ShareStore<sint> share_store;
+
+  ChunkPools chunk_pools;
+
+  unique_ptr<PrepService<sint>> prep_service;
+
   vector<Timer> join_timer;
   Timer finish_timer;
 
@@ -74,6 +87,7 @@ class Machine : public BaseMachine
   OnlineOptions opts;
 
   ExecutionStats stats;
+  Profiler profiler;
 
   ExternalClients external_clients;
 
@@ -55,6 +55,7 @@ template<class sint, class sgf2n>
 Machine<sint, sgf2n>::Machine(Names& playerNames, bool use_encryption,
     const OnlineOptions opts, int lg2)
   : my_number(playerNames.my_num()), N(playerNames),
+    Mp(opts.memtype == "mapped" ? memory_filename() + "-S" : ""),
     use_encryption(use_encryption), live_prep(opts.live_prep), opts(opts),
     external_clients(my_number)
 {
@@ -130,16 +131,24 @@ Machine<sint, sgf2n>::Machine(Names& playerNames, bool use_encryption,
 
   // Initialize the global memory
   auto memtype = opts.memtype;
-  if (memtype.compare("old")==0)
+  if (memtype.compare("old")==0 or memtype.compare("mapped")==0)
      {
        ifstream inpf;
        inpf.open(memory_filename(), ios::in | ios::binary);
-       if (inpf.fail()) { throw file_error(memory_filename()); }
-       inpf >> M2 >> Mp >> Mi;
-       if (inpf.get() != 'M')
+       if (inpf.fail())
          {
-           cerr << "Invalid memory file. Run with '-m empty'." << endl;
-           exit(1);
+           // first run with mapped memory
+           if (memtype.compare("old")==0)
+             throw file_error(memory_filename());
+         }
+       else
+         {
+           inpf >> M2 >> Mp >> Mi;
+           if (inpf.get() != 'M')
+             {
+               cerr << "Invalid memory file. Run with '-m empty'." << endl;
+               exit(1);
+             }
          }
        inpf.close();
      }
@@ -184,6 +193,12 @@ void Machine<sint, sgf2n>::prepare(const string& progname_str)
   progs[0].print_offline_cost();
 #endif
 
+  if (live_prep and opts.shared_prep > 0 and not prep_service)
+    prep_service.reset(new PrepService<sint>(opts.shared_prep,
+        [this](PrepService<sint>& service,
+            const typename PrepService<sint>::key_type& key, int worker)
+        { run_prep_worker(service, key, worker); }));
+
   /* Set up the threads */
   tinfo.resize(nthreads);
   threads.resize(nthreads);
@@ -210,6 +225,37 @@ void Machine<sint, sgf2n>::prepare(const string& progname_str)
     }
 }
 
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::run_prep_worker(PrepService<sint>& service,
+    const typename PrepService<sint>::key_type& key, int worker)
+{
+  bigint::init_thread();
+  BaseMachine::thread_num = worker;
+  BaseMachine::background_thread = true;
+
+  unique_ptr<Player> player;
+  string id = PrepService<sint>::player_name(key, worker);
+  if (use_encryption)
+    player.reset(new CryptoPlayer(N, id));
+  else
+    player.reset(new PlainPlayer(N, id));
+  Player& P = *player;
+  DataPositions usage(P.num_players());
+  typename sint::LivePrep prep(0, usage);
+  typename sint::bit_type::LivePrep bit_prep(usage);
+  GC::ShareThread<typename sint::bit_type> share_thread(bit_prep, P,
+      get_bit_mac_key());
+  typename sint::MAC_Check MCp(alphapi);
+  ArithmeticProcessor Proc(opts, worker);
+  SubProcessor<sint> proc(Proc, MCp, prep, P);
+
+  service.serve(prep, P, [&]()
+  {
+    proc.check();
+    share_thread.check();
+  }, key, worker);
+}
+
 template<class sint, class sgf2n>
 Machine<sint, sgf2n>::~Machine()
 {
@@ -372,6 +418,9 @@ DataPositions Machine<sint, sgf2n>::run_tape(int thread_number, int tape_number,
   if (size_t(tape_number) >= progs.size())
     throw overflow("invalid tape number", tape_number, progs.size());
 
+  auto range = progs[tape_number].direct_mem_range(SINT);
+  Mp.MS.prefetch(range.first, range.second);
+
   queues[thread_number]->schedule({tape_number, arg, pos});
   //printf("Send signal to run program %d in thread %d\n",tape_number,thread_number);
   //printf("Running line %d\n",exec);
@@ -399,6 +448,7 @@ DataPositions Machine<sint, sgf2n>::join_tape(int i)
   //printf("Waiting for client to terminate\n");
   auto pos = queues[i]->result().pos;
   join_timer[i].stop();
+  Mp.MS.write_behind();
   return pos;
 }
 
@@ -502,6 +552,14 @@ pair<DataPositions, NamedCommStats> Machine<sint, sgf2n>::stop_threads()
 
   auto comm_stats = total_comm();
 
+  if (prep_service)
+    {
+      prep_service->stop();
+      comm_stats += prep_service->comm;
+      prep_service->print_stats();
+      prep_service.reset();
+    }
+
   if (OnlineOptions::singleton.verbose)
     {
       NamedStats total;
@@ -509,6 +567,7 @@ pair<DataPositions, NamedCommStats> Machine<sint, sgf2n>::stop_threads()
         total += queue->stats;
       total.print();
       queues.print_breakdown();
+      ScratchPools::print(cerr);
     }
 
   for (auto& queue : queues)
@@ -599,7 +658,7 @@ void Machine<sint, sgf2n>::run(const string& progname)
       unsigned max_size = 1 << 20;
       if (M2.size_s() > max_size)
         M2.resize_s(max_size);
-      if (Mp.size_s() > max_size)
+      if (Mp.size_s() > max_size and Mp.mapped_filename.empty())
         Mp.resize_s(max_size);
     }
 
@@ -626,6 +685,8 @@ void Machine<sint, sgf2n>::run(const string& progname)
       stats.print();
     }
 
+  profiler.write(N.my_num());
+
   if (not opts.file_prep_per_thread)
     {
       Data_Files<sint, sgf2n> df(*this);
@@ -15,6 +15,8 @@ template<class T> istream& operator>>(istream& s,Memory<T>& M);
 #include "Processor/Program.h"
 #include "Tools/CheckVector.h"
 #include "Tools/DiskVector.h"
+#include "Tools/MappedVector.h"
+#include "Tools/PagedVector.h"
 
 template<class T>
 class MemoryPart
@@ -51,6 +53,10 @@ public:
       const U& indices);
 
   void minimum_size(size_t size);
+
+  // hints for memory not in RAM
+  virtual void prefetch(size_t begin, size_t end) { (void) begin, (void) end; }
+  virtual void write_behind() {}
 };
 
 template<class T, template<class> class V>
@@ -100,6 +106,21 @@ public:
     }
 };
 
+template<class T>
+class DiskMemoryPart : public MemoryPartImpl<T, DiskVector>
+{
+public:
+  void prefetch(size_t begin, size_t end)
+    {
+      DiskVector<T>::prefetch(begin, end);
+    }
+
+  void write_behind()
+    {
+      DiskVector<T>::write_behind();
+    }
+};
+
 template<class T> 
 class Memory
 {
@@ -108,9 +129,14 @@ class Memory
   MemoryPart<T>& MS;
   MemoryPartImpl<typename T::clear, CheckVector> MC;
 
-  Memory();
+  // secret memory mapped from file if non-empty
+  const string mapped_filename;
+
+  Memory(const string& mapped_filename = "");
   ~Memory();
 
+  static MemoryPart<T>* new_secret_part(const string& mapped_filename);
+
   void resize_s(size_t sz)
     { MS.resize(sz); }
   void resize_c(size_t sz)
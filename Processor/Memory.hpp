@@ -1,5 +1,6 @@
 #include "Processor/Memory.h"
 #include "Processor/Instruction.h"
+#include "Tools/MemoryPolicy.h"
 
 #include <fstream>
 
@@ -78,14 +79,28 @@ void MemoryPart<T>::minimum_size(size_t size)
 }
 
 template<class T>
-Memory<T>::Memory() :
-    MS(
-        *(OnlineOptions::singleton.disk_memory.size() ?
-            static_cast<MemoryPart<T>*>(new MemoryPartImpl<T, DiskVector>) :
-            static_cast<MemoryPart<T>*>(new MemoryPartImpl<T, CheckVector>)))
+Memory<T>::Memory(const string& mapped_filename) :
+    MS(*new_secret_part(mapped_filename)), mapped_filename(mapped_filename)
 {
 }
 
+template<class T>
+MemoryPart<T>* Memory<T>::new_secret_part(const string& mapped_filename)
+{
+  if (mapped_filename.size())
+    {
+      auto res = new MemoryPartImpl<T, MappedVector>;
+      res->open(mapped_filename);
+      return res;
+    }
+  else if (OnlineOptions::singleton.disk_memory.size())
+    return new DiskMemoryPart<T>;
+  else if (MemoryPolicy::get().active)
+    return new MemoryPartImpl<T, PagedVector>;
+  else
+    return new MemoryPartImpl<T, CheckVector>;
+}
+
 template<class T>
 Memory<T>::~Memory()
 {
@@ -95,11 +110,13 @@ Memory<T>::~Memory()
 template<class T>
 ostream& operator<<(ostream& s,const Memory<T>& M)
 {
-  s << M.MS.size() << endl;
+  // mapped secret memory is stored separately
+  size_t n_secret = M.mapped_filename.empty() ? M.MS.size() : 0;
+  s << n_secret << endl;
   s << M.MC.size() << endl;
 
 #ifdef OUTPUT_HUMAN_READABLE_MEMORY
-  for (unsigned int i=0; i<M.MS.size(); i++)
+  for (unsigned int i=0; i<n_secret; i++)
     { M.MS[i].output(s,true); s << endl; }
   s << endl;
 
@@ -107,7 +124,7 @@ ostream& operator<<(ostream& s,const Memory<T>& M)
     {  M.MC[i].output(s,true); s << endl; }
   s << endl;
 #else
-  for (unsigned int i=0; i<M.MS.size(); i++)
+  for (unsigned int i=0; i<n_secret; i++)
     { M.MS[i].output(s,false); }
 
   for (unsigned int i=0; i<M.MC.size(); i++)
@@ -125,11 +142,14 @@ istream& operator>>(istream& s,Memory<T>& M)
 
   s >> len;  
   M.MS.minimum_size(len);
+  // mapped secret memory persists in its own file, and the stream
+  // only contains secrets when switching from another memory type
+  size_t n_secret = M.mapped_filename.empty() ? M.MS.size() : len;
   s >> len;
   M.MC.minimum_size(len);
   s.seekg(1, istream::cur);
 
-  for (unsigned int i=0; i<M.MS.size(); i++)
+  for (unsigned int i=0; i<n_secret; i++)
     { M.MS[i].input(s,false);  }
 
   for (unsigned int i=0; i<M.MC.size(); i++)
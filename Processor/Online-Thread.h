@@ -10,6 +10,7 @@
 using namespace std;
 
 template<class sint, class sgf2n> class Machine;
+template<class T> class EdabitFactory;
 
 template<class sint, class sgf2n>
 class thread_info
@@ -33,6 +34,7 @@ class thread_info
       const char* name);
 
   void Sub_Main_Func();
+  void run_edabit_factory(EdabitFactory<sint>& factory);
   void Main_Func_With_Purge();
 };
 
@@ -2,6 +2,7 @@
 #include "Processor/Program.h"
 #include "Processor/Online-Thread.h"
 #include "Tools/time-func.h"
+#include "Tools/MemoryPolicy.h"
 #include "Processor/Data_Files.h"
 #include "Processor/Machine.h"
 #include "Processor/Processor.h"
@@ -14,6 +15,7 @@
 #include "Processor/Instruction.hpp"
 #include "Processor/Input.hpp"
 #include "Protocols/LimitedPrep.hpp"
+#include "Protocols/EdabitFactory.hpp"
 #include "GC/BitAdder.hpp"
 
 #include <iostream>
@@ -41,6 +43,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
 
   int num=tinfo->thread_num;
   BaseMachine::s().thread_num = num;
+  MemoryPolicy::get().pin_thread(num);
 
   auto& queues = machine.queues[num];
   auto& opts = machine.opts;
@@ -102,6 +105,18 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   processor = new Processor<sint, sgf2n>(tinfo->thread_num,P,*MC2,*MCp,machine,progs.at(thread_num > 0));
   auto& Proc = *processor;
 
+  unique_ptr<EdabitFactory<sint>> edabit_factory;
+  auto buffer_prep = dynamic_cast<BufferPrep<sint>*>(&Proc.DataF.DataFp);
+  if (machine.prep_service and buffer_prep)
+    buffer_prep->prep_service = machine.prep_service.get();
+  else if (machine.live_prep and opts.background_prep > 0 and buffer_prep)
+    {
+      edabit_factory.reset(new EdabitFactory<sint>(opts.background_prep,
+          [this](EdabitFactory<sint>& factory)
+          { run_edabit_factory(factory); }));
+      buffer_prep->edabit_factory = edabit_factory.get();
+    }
+
   // don't count communication for initialization
   P.reset_stats();
 
@@ -274,6 +289,9 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
           Proc.DataF.seekg(job.pos);
           // reset for actual usage
           Proc.DataF.reset_usage();
+
+          if (edabit_factory)
+            edabit_factory->declare(progs[program].get_offline_data_used());
              
           //printf("\tExecuting program");
           // Execute the program
@@ -311,6 +329,19 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   online_timer.stop(P.total_comm());
   online_prep_timer += Proc.DataF.total_time();
 
+  auto total_comm = P.total_comm();
+  if (buffer_prep)
+    buffer_prep->prep_service = 0;
+  if (edabit_factory)
+    {
+      edabit_factory->stop();
+      buffer_prep->edabit_factory = 0;
+      total_comm += edabit_factory->comm;
+      if (OnlineOptions::singleton.verbose)
+        cerr << "Thread " << num << " spent " << edabit_factory->timer.elapsed()
+            << " seconds on background preprocessing" << endl;
+    }
+
   if (machine.opts.file_prep_per_thread)
     Proc.DataF.prune();
 
@@ -349,6 +380,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
 
   // wind down thread by thread
   machine.stats += Proc.stats;
+  machine.profiler.add(Proc.profiler);
   queues->timers["wait"] = wait_timer + queues->wait_timer;
   timer.stop(P.total_comm());
   queues->timers["online"] = online_timer - online_prep_timer - queues->wait_timer;
@@ -363,6 +395,8 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   stats["ANDs"] = Proc.share_thread.protocol->bit_counter;
   stats["AND rounds"] = Proc.share_thread.protocol->rounds;
   stats["integer openings"] = MCp->values_opened;
+  stats["integer MAC checks"] = MCp->checks;
+  stats["integer MAC-checked openings"] = MCp->values_checked;
   stats["integer inputs"] = Proc.Procp.input.values_input;
   for (auto x : Proc.Procp.shuffler.stats)
     stats["shuffles of length " + to_string(x.first)] = x.second;
@@ -391,7 +425,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   Proc.DataF.set_usage(actual_usage);
   delete processor;
 
-  queues->finished(actual_usage, P.total_comm(), stats);
+  queues->finished(actual_usage, total_comm, stats);
 
   delete MC2;
   delete MCp;
@@ -403,6 +437,38 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
 }
 
 
+template<class sint, class sgf2n>
+void thread_info<sint, sgf2n>::run_edabit_factory(EdabitFactory<sint>& factory)
+{
+  bigint::init_thread();
+  BaseMachine::thread_num = thread_num;
+  BaseMachine::background_thread = true;
+
+  unique_ptr<Player> player;
+  string id = "thread" + to_string(thread_num) + "-factory";
+  if (machine->use_encryption)
+    player.reset(new CryptoPlayer(*Nms, id));
+  else
+    player.reset(new PlainPlayer(*Nms, id));
+  Player& P = *player;
+  DataPositions usage(P.num_players());
+  typename sint::LivePrep prep(0, usage);
+  typename sint::bit_type::LivePrep bit_prep(usage);
+  GC::ShareThread<typename sint::bit_type> share_thread(bit_prep, P,
+      machine->get_bit_mac_key());
+  typename sint::MAC_Check MCp(*alphapi);
+  ArithmeticProcessor Proc(machine->opts, thread_num);
+  SubProcessor<sint> proc(Proc, MCp, prep, P);
+
+  factory.serve(prep, [&]()
+  {
+    proc.check();
+    share_thread.check();
+  });
+
+  factory.comm = P.total_comm();
+}
+
 template<class sint, class sgf2n>
 void* thread_info<sint, sgf2n>::Main_Func(void* ptr)
 {
@@ -9,6 +9,7 @@
 #include "Math/gfpvar.h"
 #include "Protocols/HemiOptions.h"
 #include "Protocols/config.h"
+#include "Tools/MemoryPolicy.h"
 
 #include "Math/gfp.hpp"
 
@@ -25,6 +26,8 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     lgp = gfp0::MAX_N_BITS;
     live_prep = true;
     batch_size = 1000;
+    background_prep = 0;
+    shared_prep = 0;
     memtype = "empty";
     bits_from_squares = false;
     direct = false;
@@ -37,7 +40,9 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     trunc_error = DEFAULT_SECURITY;
     opening_sum = 0;
     max_broadcast = 0;
+    mac_check_budget = 0;
     receive_threads = false;
+    profile_period = 100;
 #ifdef VERBOSE
     verbose = true;
 #else
@@ -114,6 +119,27 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-B", // Flag token.
             "--bucket-size" // Flag token.
     );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Sample instructions and write wall time, rounds, and bytes "
+            "per tape, basic block, and source line (compile with -d) to "
+            "{prefix}-P{id}-{time,rounds,bytes}.folded for flamegraph.pl", // Help description.
+            "-prof", // Flag token.
+            "--profile" // Flag token.
+    );
+    opt.add(
+            to_string(profile_period).c_str(), // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            ("Average number of instructions per profiling sample (default: "
+                    + to_string(profile_period) + ")").c_str(), // Help description.
+            "-profp", // Flag token.
+            "--profile-period" // Flag token.
+    );
     opt.add(
             "", // Default.
             0, // Required?
@@ -144,6 +170,8 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
     opt.get("-OF")->getString(cmd_private_output_file);
 
     opt.get("--bucket-size")->getInt(bucket_size);
+    opt.get("--profile")->getString(profile_file);
+    opt.get("--profile-period")->getInt(profile_period);
 
 #ifndef VERBOSE
     verbose = opt.isSet("--verbose");
@@ -242,14 +270,38 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-b", // Flag token.
             "--batch-size" // Flag token.
     );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Number of daBit/edaBit batches per type to generate in "
+            "a background thread with live preprocessing (default: 0)", // Help description.
+            "-bp", // Flag token.
+            "--background-prep" // Flag token.
+    );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Number of threads per preprocessing type generating "
+            "for all online threads with live preprocessing "
+            "(default: 0, i.e., generate in every thread)", // Help description.
+            "-sp", // Flag token.
+            "--shared-prep" // Flag token.
+    );
     opt.add(
             memtype.c_str(), // Default.
             0, // Required?
             1, // Number of args expected.
             0, // Delimiter if expecting multiple args.
-            "Where to obtain memory, old|empty (default: empty)\n\t"
+            "Where to obtain memory, old|empty|mapped (default: empty)\n\t"
             "old: reuse previous memory in Memory-<type>-P<i>\n\t"
-            "empty: create new empty memory", // Help description.
+            "empty: create new empty memory\n\t"
+            "mapped: like old but map secret memory from "
+            "Memory-<type>-P<i>-S,\n\t"
+            "which only writes back modified pages", // Help description.
             "-m", // Flag token.
             "--memory" // Flag token.
     );
@@ -293,6 +345,8 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
         file_prep_per_thread = true;
     }
     opt.get("-b")->getInt(batch_size);
+    opt.get("-bp")->getInt(background_prep);
+    opt.get("-sp")->getInt(shared_prep);
     opt.get("--memory")->getString(memtype);
     bits_from_squares = opt.isSet("-Q");
 
@@ -427,10 +481,26 @@ void OnlineOptions::finalize_with_error(ez::ezOptionParser& opt)
     if (o)
         o->getInt(max_broadcast);
 
+    o = opt.get("--mac-check-budget");
+    if (o)
+    {
+        o->getInt(mac_check_budget);
+        if (mac_check_budget < 0)
+            throw runtime_error("MAC check budget must be non-negative");
+    }
+
     o = opt.get("--disk-memory");
     if (o)
         o->getString(disk_memory);
 
+    o = opt.get("--memory-policy");
+    if (o)
+    {
+        o->getString(memory_policy);
+        // fail early on unknown items
+        MemoryPolicy().parse(memory_policy);
+    }
+
     receive_threads = opt.isSet("--threads");
 
     if (use_security_parameter)
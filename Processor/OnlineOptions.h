@@ -24,6 +24,8 @@ public:
     int playerno;
     std::string progname;
     int batch_size;
+    int background_prep;
+    int shared_prep;
     std::string memtype;
     bool bits_from_squares;
     bool direct;
@@ -36,8 +38,12 @@ public:
     bool file_prep_per_thread;
     int trunc_error;
     int opening_sum, max_broadcast;
+    int mac_check_budget;
     bool receive_threads;
     std::string disk_memory;
+    std::string memory_policy;
+    std::string profile_file;
+    int profile_period;
     vector<long> args;
     vector<string> options;
     string executable;
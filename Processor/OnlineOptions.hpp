@@ -55,9 +55,19 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
               "-mb", // Flag token.
               "--max-broadcast" // Flag token.
         );
+        opt.add(
+              "0", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Defer MAC checks until n MB of opened values and MACs "
+              "are pending (default: 0 for a fixed number of values)", // Help description.
+              "--mac-check-budget" // Flag token.
+        );
     }
 
     if (not T::clear::binary)
+    {
         opt.add(
               "", // Default.
               0, // Required?
@@ -68,6 +78,21 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
               "-D", // Flag token.
               "--disk-memory" // Flag token.
         );
+        opt.add(
+              "", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Page size and NUMA placement of secret memory, "
+              "comma-separated list of\n\t"
+              "thp: transparent huge pages\n\t"
+              "huge: explicit huge pages (see /proc/sys/vm/nr_hugepages)\n\t"
+              "interleave: spread pages over all NUMA nodes\n\t"
+              "local: place pages on the node of first use\n\t"
+              "pin: bind threads to NUMA nodes round-robin", // Help description.
+              "--memory-policy" // Flag token.
+        );
+    }
 
     if (T::variable_players)
         opt.add(
@@ -22,6 +22,7 @@
 #include "GC/ShareThread.h"
 #include "Protocols/SecureShuffle.h"
 #include "Tools/NamedStats.h"
+#include "ChunkPool.h"
 
 class Program;
 
@@ -213,6 +214,11 @@ class Processor : public ArithmeticProcessor
   // avoid re-computation of expensive division
   vector<cint> inverses2m;
 
+  // chunks of dynamically distributed loops granted by party 0
+  map<int, ChunkPool::Range> chunk_grants;
+  // all grants for comparison among parties
+  octetStream chunk_log;
+
   public:
   Data_Files<sint, sgf2n> DataF;
   Player& P;
@@ -295,6 +301,13 @@ class Processor : public ArithmeticProcessor
       const vector<int>& data_registers, size_t vector_size);
   void write_shares_to_file(long start_pos, const vector<int>& data_registers,
       size_t vector_size);
+
+  // Same for named tables in ShareStore
+  void read_shares_from_table(const string& name, long start_pos,
+      int end_pos_register, const vector<int>& data_registers,
+      size_t vector_size);
+  void write_shares_to_table(const string& name, long start_pos,
+      const vector<int>& data_registers, size_t vector_size);
   
   cint get_inverse2(unsigned m);
 
@@ -308,6 +321,10 @@ class Processor : public ArithmeticProcessor
 
   void call_tape(int tape_number, int arg, const vector<int>& results);
 
+  // next chunk of dynamically distributed loop as decided by party 0
+  long next_chunk(int pool, long owner);
+  void check_chunks();
+
   private:
 
   template<class T> friend class SPDZ;
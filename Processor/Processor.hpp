@@ -11,6 +11,9 @@
 #include "GC/Processor.hpp"
 #include "GC/ShareThread.hpp"
 #include "Protocols/SecureShuffle.hpp"
+#include "Processor/ShareStore.hpp"
+#include "Tools/ScratchVector.h"
+#include "Tools/Bundle.h"
 
 #include <sodium.h>
 #include <string>
@@ -114,6 +117,8 @@ Processor<sint, sgf2n>::Processor(int thread_num,Player& P,
 
   setup_redirection(P.my_num(), thread_num, opts, out, sint::real_shares(P));
   Procb.out = out;
+
+  profiler.set_player(P);
 }
 
 
@@ -121,6 +126,10 @@ template<class sint, class sgf2n>
 Processor<sint, sgf2n>::~Processor()
 {
   share_thread.post_run();
+  ScratchPools::add("registers",
+      Procp.get_S().capacity_bytes() + Procp.get_C().capacity_bytes()
+          + Proc2.get_S().capacity_bytes() + Proc2.get_C().capacity_bytes()
+          + Ci.capacity_bytes());
 #ifdef VERBOSE
   if (sent)
     cerr << "Opened " << sent << " elements in " << rounds << " rounds" << endl;
@@ -446,6 +455,37 @@ void Processor<sint, sgf2n>::write_shares_to_file(long start_pos,
   binary_file_io.write_to_file(filename, inpbuf, start_pos);
 }
 
+template<class sint, class sgf2n>
+void Processor<sint, sgf2n>::read_shares_from_table(const string& name,
+    long start_pos, int end_pos_register, const vector<int>& data_registers,
+    size_t vector_size)
+{
+  if (not sint::real_shares(P))
+    return;
+
+  auto table = machine.share_store.get(name, P.my_num(), false);
+  if (table)
+    write_Ci(end_pos_register,
+        table->read(Procp.get_S(), data_registers, vector_size, start_pos));
+  else
+    {
+      if (OnlineOptions::singleton.has_option("verbose_persistence"))
+        cerr << "Table " << name << " missing, will return -2." << endl;
+      write_Ci(end_pos_register, -2);
+    }
+}
+
+template<class sint, class sgf2n>
+void Processor<sint, sgf2n>::write_shares_to_table(const string& name,
+    long start_pos, const vector<int>& data_registers, size_t vector_size)
+{
+  if (not sint::real_shares(P))
+    return;
+
+  machine.share_store.get(name, P.my_num(), true)->write(Procp.get_S(),
+      data_registers, vector_size, start_pos);
+}
+
 template<class T>
 void SubProcessor<T>::maybe_check()
 {
@@ -1150,4 +1190,53 @@ void Processor<sint, sgf2n>::call_tape(int tape_number, int arg,
   arg_stack.pop_back();
 }
 
+template<class sint, class sgf2n>
+long Processor<sint, sgf2n>::next_chunk(int pool, long owner)
+{
+  // only communicate when the last grant is used up
+  auto& grant = chunk_grants[pool];
+  if (grant.size() <= 0)
+    {
+      octetStream os;
+      if (P.my_num() == 0)
+        {
+          grant = machine.chunk_pools[pool].next(owner);
+          os.store_int(grant.begin, 8);
+          os.store_int(grant.end, 8);
+          P.send_all(os);
+        }
+      else
+        {
+          P.receive_player(0, os);
+          grant.begin = os.get_int(8);
+          grant.end = os.get_int(8);
+        }
+
+      chunk_log.store_int(pool, 8);
+      chunk_log.store_int(grant.begin, 8);
+      chunk_log.store_int(grant.end, 8);
+
+      if (grant.size() <= 0)
+        {
+          check_chunks();
+          return -1;
+        }
+    }
+
+  return grant.begin++;
+}
+
+template<class sint, class sgf2n>
+void Processor<sint, sgf2n>::check_chunks()
+{
+  // party 0 could send different schedules to different parties
+  if (sint::malicious)
+    {
+      Bundle<octetStream> bundle(P);
+      bundle.mine = chunk_log;
+      bundle.compare_hash(P);
+    }
+  chunk_log.reset_write_head();
+}
+
 #endif
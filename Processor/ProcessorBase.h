@@ -12,6 +12,7 @@
 using namespace std;
 
 #include "Tools/ExecutionStats.h"
+#include "Profiler.h"
 #include "Tools/SwitchableOutput.h"
 #include "OnlineOptions.h"
 #include "Math/Integer.h"
@@ -36,6 +37,7 @@ protected:
 
 public:
   ExecutionStats stats;
+  Profiler profiler;
 
   ofstream stdout_redirect_file;
 
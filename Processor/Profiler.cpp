@@ -0,0 +1,164 @@
+/*
+ * Profiler.cpp
+ *
+ */
+
+#include "Profiler.h"
+#include "OnlineOptions.h"
+#include "Networking/Player.h"
+#include "Processor/instructions.h"
+#include "GC/instructions.h"
+
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <assert.h>
+
+Profiler::Profiler() :
+        countdown(1), P(0)
+{
+    auto& opts = OnlineOptions::singleton;
+    period = opts.profile_file.empty() ? 0 : max(1, opts.profile_period);
+    next();
+}
+
+void Profiler::set_player(const Player& P)
+{
+    this->P = &P;
+}
+
+bool Profiler::next()
+{
+    if (period == 0)
+    {
+        countdown = SIZE_MAX;
+        return false;
+    }
+
+    // random intervals avoid aliasing with loops
+    countdown = uniform_int_distribution<size_t>(1, 2 * period - 1)(prng);
+    return true;
+}
+
+void Profiler::get_comm(size_t& rounds, size_t& bytes)
+{
+    rounds = bytes = 0;
+    if (P)
+        for (auto& x : P->total_comm())
+        {
+            rounds += x.second.rounds;
+            bytes += x.second.data;
+        }
+}
+
+void Profiler::start()
+{
+    running.push_back({});
+    auto& snapshot = running.back();
+    get_comm(snapshot.rounds, snapshot.bytes);
+}
+
+void Profiler::stop(const string& tape, const vector<string>& locations,
+        unsigned PC, int opcode)
+{
+    assert(not running.empty());
+    auto& snapshot = running.back();
+    size_t rounds, bytes;
+    get_comm(rounds, bytes);
+
+    string stack = tape + ";";
+    if (PC < locations.size())
+        stack += locations[PC] + ";";
+    stack += opcode_name(opcode);
+
+    auto& entry = entries[stack];
+    entry.time += snapshot.timer.elapsed();
+    entry.rounds += rounds - snapshot.rounds;
+    entry.bytes += bytes - snapshot.bytes;
+    entry.samples++;
+    running.pop_back();
+}
+
+string Profiler::opcode_name(int opcode)
+{
+    switch (opcode)
+    {
+#define X(NAME, PRE, CODE) case NAME: return #NAME;
+    ALL_INSTRUCTIONS
+#undef X
+#define X(NAME, CODE) case NAME: return #NAME;
+    COMBI_INSTRUCTIONS
+#undef X
+    default:
+        stringstream ss;
+        ss << hex << showbase << opcode;
+        return ss.str();
+    }
+}
+
+vector<string> Profiler::read_locations(const string& bytecode_filename,
+        size_t n_instructions)
+{
+    vector<string> res;
+    if (OnlineOptions::singleton.profile_file.empty())
+        return res;
+
+    string filename = bytecode_filename.substr(0,
+            bytecode_filename.rfind(".bc")) + ".loc";
+    ifstream file(filename);
+    string line;
+    while (getline(file, line))
+        res.push_back(line);
+
+    if (res.size() != n_instructions)
+    {
+        if (not res.empty())
+            cerr << "Ignoring outdated " << filename << endl;
+        res.clear();
+    }
+
+    return res;
+}
+
+void Profiler::add(const Profiler& other)
+{
+    static mutex lock;
+    lock_guard<mutex> _(lock);
+    period = max(period, other.period);
+    for (auto& x : other.entries)
+    {
+        auto& entry = entries[x.first];
+        entry.time += x.second.time;
+        entry.rounds += x.second.rounds;
+        entry.bytes += x.second.bytes;
+        entry.samples += x.second.samples;
+    }
+}
+
+void Profiler::write(int my_num)
+{
+    auto& prefix = OnlineOptions::singleton.profile_file;
+    if (prefix.empty())
+        return;
+
+    // estimates in flamegraph input format
+    string filename = prefix + "-P" + to_string(my_num);
+    ofstream time(filename + "-time.folded"),
+            rounds(filename + "-rounds.folded"),
+            bytes(filename + "-bytes.folded");
+    for (auto& x : entries)
+    {
+        auto& entry = x.second;
+        if (entry.time)
+            time << x.first << " "
+                    << size_t(entry.time * 1e6 * period + 0.5) << endl;
+        if (entry.rounds)
+            rounds << x.first << " " << entry.rounds * period << endl;
+        if (entry.bytes)
+            bytes << x.first << " " << entry.bytes * period << endl;
+    }
+
+    cerr << "Profile written to " << filename
+            << "-{time,rounds,bytes}.folded (microseconds, rounds, bytes)"
+            << endl;
+}
@@ -0,0 +1,86 @@
+/*
+ * Profiler.h
+ *
+ */
+
+#ifndef PROCESSOR_PROFILER_H_
+#define PROCESSOR_PROFILER_H_
+
+#include "Tools/time-func.h"
+
+#include <map>
+#include <vector>
+#include <string>
+#include <random>
+using namespace std;
+
+class Player;
+
+/**
+ * Sampling profiler for the virtual machines.
+ * On average every ``period``-th instruction is measured completely
+ * (wall time, communication rounds and bytes),
+ * and the results are attributed to tape, basic block, and source line
+ * if the compiler output debug information (``compile.py -d``).
+ * Inactive unless ``--profile`` is given,
+ * in which case the cost is one decrement per instruction.
+ */
+class Profiler
+{
+    struct Snapshot
+    {
+        RunningTimer timer;
+        size_t rounds, bytes;
+    };
+
+    struct Entry
+    {
+        double time;
+        size_t rounds, bytes, samples;
+
+        Entry() : time(0), rounds(0), bytes(0), samples(0) {}
+    };
+
+    size_t countdown;
+    size_t period;
+    minstd_rand prng;
+
+    const Player* P;
+
+    vector<Snapshot> running;
+    map<string, Entry> entries;
+
+    bool next();
+    void get_comm(size_t& rounds, size_t& bytes);
+
+    static string opcode_name(int opcode);
+
+public:
+    // location per instruction from compiler or empty
+    static vector<string> read_locations(const string& bytecode_filename,
+            size_t n_instructions);
+
+    Profiler();
+
+    void set_player(const Player& P);
+
+    // true if the next instruction should be measured
+    bool tick()
+    {
+        if (--countdown)
+            return false;
+        else
+            return next();
+    }
+
+    void start();
+    void stop(const string& tape, const vector<string>& locations,
+            unsigned PC, int opcode);
+
+    // thread-safe
+    void add(const Profiler& other);
+
+    void write(int my_num);
+};
+
+#endif /* PROCESSOR_PROFILER_H_ */
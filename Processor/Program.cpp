@@ -5,12 +5,15 @@
 
 #include "Processor/Instruction.hpp"
 
+#include <boost/filesystem.hpp>
+
 void Program::compute_constants()
 {
   for (int reg_type = 0; reg_type < MAX_REG_TYPE; reg_type++)
     {
       max_reg[reg_type] = 0;
       max_mem[reg_type] = 0;
+      min_mem[reg_type] = SIZE_MAX;
     }
   for (unsigned int i=0; i<p.size(); i++)
     {
@@ -22,8 +25,11 @@ void Program::compute_constants()
               p[i].get_max_reg(reg_type));
           max_mem[reg_type] = max(max_mem[reg_type],
               p[i].get_mem(RegType(reg_type)));
+          if (p[i].get_mem(RegType(reg_type)))
+            min_mem[reg_type] = min(min_mem[reg_type], p[i].get_n());
         }
-      writes_persistence |= p[i].opcode == WRITEFILESHARE;
+      writes_persistence |= p[i].opcode == WRITEFILESHARE
+          or p[i].opcode == WRITETABLESHARE;
     }
 }
 
@@ -52,25 +58,7 @@ void Program::parse_with_error(string filename)
   if (pinp.fail())
     throw file_error(filename);
 
-  try
-  {
-    parse(pinp);
-  }
-  catch (bytecode_error& e)
-  {
-    stringstream os;
-    os << "Cannot parse " << filename << " (" << e.what() << ")" << endl;
-    os << "Does the compiler version match the virtual machine? "
-        << "If in doubt, recompile the VM";
-    if (not OnlineOptions::singleton.executable.empty())
-      os << " using 'make " << OnlineOptions::singleton.executable << "'";
-    os << ".";
-    throw bytecode_error(os.str());
-  }
-
   // compute hash
-  pinp.clear();
-  pinp.seekg(0);
   Hash hasher;
   while (pinp.peek(), !pinp.eof())
     {
@@ -79,6 +67,34 @@ void Program::parse_with_error(string filename)
       hasher.update(buf, n);
     }
   hash = hasher.final().str();
+
+  cache.reset(TapeCache::open(filename, *this));
+
+  if (not cache)
+    {
+      pinp.clear();
+      pinp.seekg(0);
+
+      try
+      {
+        parse(pinp);
+      }
+      catch (bytecode_error& e)
+      {
+        stringstream os;
+        os << "Cannot parse " << filename << " (" << e.what() << ")" << endl;
+        os << "Does the compiler version match the virtual machine? "
+            << "If in doubt, recompile the VM";
+        if (not OnlineOptions::singleton.executable.empty())
+          os << " using 'make " << OnlineOptions::singleton.executable << "'";
+        os << ".";
+        throw bytecode_error(os.str());
+      }
+
+      TapeCache::write(filename, *this);
+    }
+
+  locations = Profiler::read_locations(filename, size());
 }
 
 void Program::parse(istream& s)
@@ -111,9 +127,17 @@ void Program::parse(istream& s)
       //cerr << "\t" << instr << endl;
       s.peek();
     }
+  n_instructions = p.size();
+  cache.reset();
   compute_constants();
 }
 
+void Program::load() const
+{
+  if (cache)
+    cache->load(p);
+}
+
 void Program::print_offline_cost() const
 {
   if (unknown_usage)
@@ -129,6 +153,7 @@ void Program::print_offline_cost() const
 
 ostream& operator<<(ostream& s,const Program& P)
 {
+  P.load();
   for (unsigned int i=0; i<P.p.size(); i++)
     { s << i << " :: " << P.p[i] << endl; }
   return s;
@@ -3,6 +3,9 @@
 
 #include "Processor/Instruction.h"
 #include "Processor/Data_Files.h"
+#include "Processor/TapeCache.h"
+
+#include <memory>
 
 template<class sint, class sgf2n> class Machine;
 
@@ -10,7 +13,13 @@ template<class sint, class sgf2n> class Machine;
 
 class Program
 {
-  vector<Instruction> p;
+  friend class TapeCache;
+
+  // decoded from cache when first needed if applicable
+  mutable vector<Instruction> p;
+  shared_ptr<TapeCache> cache;
+  size_t n_instructions;
+
   // Here we note the number of bits, squares and triples and input
   // data needed
   //  - This is computed for a whole program sequence to enable
@@ -22,6 +31,8 @@ class Program
 
   // Memory size used directly
   size_t max_mem[MAX_REG_TYPE];
+  // Lowest memory address used directly
+  size_t min_mem[MAX_REG_TYPE];
 
   // True if program contains variable-sized loop
   bool unknown_usage;
@@ -30,17 +41,23 @@ class Program
 
   string name;
 
+  // source locations for profiling
+  vector<string> locations;
+
   void compute_constants();
 
   public:
 
   bool writes_persistence;
 
-  Program(int nplayers) : offline_data_used(nplayers),
+  Program(int nplayers) : n_instructions(0), offline_data_used(nplayers),
       unknown_usage(false), writes_persistence(false)
     { compute_constants(); }
 
-  size_t size() const { return p.size(); }
+  size_t size() const { return n_instructions; }
+
+  // make sure that instructions are available
+  void load() const;
 
   // Read in a program
   void parse(string filename);
@@ -58,6 +75,10 @@ class Program
   size_t direct_mem(RegType reg_type) const
     { return max_mem[reg_type]; }
 
+  // range of addresses accessed directly, empty if none
+  pair<size_t, size_t> direct_mem_range(RegType reg_type) const
+    { return {min(min_mem[reg_type], max_mem[reg_type]), max_mem[reg_type]}; }
+
   const string& get_hash() const
     { return hash; }
 
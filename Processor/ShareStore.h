@@ -0,0 +1,81 @@
+/*
+ * ShareStore.h
+ *
+ */
+
+#ifndef PROCESSOR_SHARESTORE_H_
+#define PROCESSOR_SHARESTORE_H_
+
+#include "Tools/Hash.h"
+#include "Tools/CheckVector.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <array>
+#include <sys/types.h>
+using namespace std;
+
+/**
+ * Named table of persistent shares in
+ * ``Persistence/<name>-P<i>.table``.
+ * The file signature determines the share type,
+ * and the index file next to it holds the number of shares
+ * and a checksum per chunk.
+ * Accesses only touch the relevant chunks,
+ * and reads from several threads run concurrently.
+ */
+template<class T>
+class ShareTable
+{
+    static constexpr size_t CHUNK_SIZE = 1 << 12;
+
+    typedef array<unsigned char, Hash::hash_length> checksum_type;
+
+    string filename;
+    int fd;
+    size_t data_start;
+    size_t n_shares;
+    vector<checksum_type> checksums;
+
+    shared_mutex lock;
+
+    void read_raw(char* buffer, size_t start, size_t n);
+    void write_raw(const char* buffer, size_t n_bytes, off_t offset);
+
+    checksum_type checksum(const char* buffer, size_t n);
+    void verify(const char* buffer, size_t first_chunk, size_t n);
+    void update_checksums(size_t start, size_t n);
+
+    void read_index();
+    void write_index();
+
+public:
+    ShareTable(const string& filename, bool create);
+    ~ShareTable();
+
+    size_t size();
+
+    // returns new position or -1 at the end
+    long read(StackedVector<T>& dest, const vector<int>& regs,
+            size_t vector_size, long start);
+    // appends if start is -1
+    void write(StackedVector<T>& source, const vector<int>& regs,
+            size_t vector_size, long start);
+};
+
+template<class T>
+class ShareStore
+{
+    map<string, unique_ptr<ShareTable<T>>> tables;
+    mutex lock;
+
+public:
+    static string filename(const string& name, int my_num);
+
+    // returns 0 if table doesn't exist and create is not set
+    ShareTable<T>* get(const string& name, int my_num, bool create);
+};
+
+#endif /* PROCESSOR_SHARESTORE_H_ */
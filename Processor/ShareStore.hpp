@@ -0,0 +1,262 @@
+/*
+ * ShareStore.hpp
+ *
+ */
+
+#ifndef PROCESSOR_SHARESTORE_HPP_
+#define PROCESSOR_SHARESTORE_HPP_
+
+#include "ShareStore.h"
+#include "Tools/Buffer.h"
+#include "Tools/mkpath.h"
+#include "Tools/int.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <sstream>
+
+template<class T>
+ShareTable<T>::ShareTable(const string& filename, bool create) :
+        filename(filename), n_shares(0)
+{
+    fd = open(filename.c_str(), O_RDWR | (create ? O_CREAT : 0), 0600);
+    if (fd < 0)
+        throw file_error(filename + ": " + strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st))
+        throw file_error(filename + ": " + strerror(errno));
+
+    if (st.st_size == 0)
+    {
+        stringstream ss;
+        file_signature<T>().output(ss);
+        auto signature = ss.str();
+        data_start = signature.size();
+        write_raw(signature.c_str(), signature.size(), 0);
+        write_index();
+    }
+    else
+    {
+        ifstream file(filename, ios::in | ios::binary);
+        check_file_signature<T>(file, filename);
+        data_start = file.tellg();
+        read_index();
+        if (data_start + n_shares * T::size() > size_t(st.st_size))
+            throw persistence_error(filename + " shorter than its index");
+    }
+}
+
+template<class T>
+ShareTable<T>::~ShareTable()
+{
+    close(fd);
+}
+
+template<class T>
+size_t ShareTable<T>::size()
+{
+    shared_lock<shared_mutex> l(lock);
+    return n_shares;
+}
+
+template<class T>
+void ShareTable<T>::read_raw(char* buffer, size_t start, size_t n)
+{
+    size_t n_bytes = n * T::size();
+    off_t offset = data_start + start * T::size();
+    while (n_bytes > 0)
+    {
+        auto res = pread(fd, buffer, n_bytes, offset);
+        if (res <= 0)
+            throw persistence_error(
+                    "IO problem when reading from " + filename);
+        buffer += res;
+        offset += res;
+        n_bytes -= res;
+    }
+}
+
+template<class T>
+void ShareTable<T>::write_raw(const char* buffer, size_t n_bytes, off_t offset)
+{
+    while (n_bytes > 0)
+    {
+        auto res = pwrite(fd, buffer, n_bytes, offset);
+        if (res <= 0)
+            throw persistence_error(
+                    "IO problem when writing to " + filename);
+        buffer += res;
+        offset += res;
+        n_bytes -= res;
+    }
+}
+
+template<class T>
+typename ShareTable<T>::checksum_type ShareTable<T>::checksum(
+        const char* buffer, size_t n)
+{
+    Hash hash;
+    hash.update(buffer, n * T::size());
+    checksum_type res;
+    hash.final(res.data());
+    return res;
+}
+
+template<class T>
+void ShareTable<T>::verify(const char* buffer, size_t first_chunk, size_t n)
+{
+    for (size_t i = 0; i < n; i += CHUNK_SIZE)
+        if (checksum(buffer + i * T::size(), min(CHUNK_SIZE, n - i))
+                != checksums.at(first_chunk + i / CHUNK_SIZE))
+            throw persistence_error(
+                    "checksum mismatch in " + filename + " for shares from "
+                            + to_string(first_chunk * CHUNK_SIZE + i));
+}
+
+template<class T>
+void ShareTable<T>::update_checksums(size_t start, size_t n)
+{
+    checksums.resize(DIV_CEIL(n_shares, CHUNK_SIZE));
+    vector<char> buffer(CHUNK_SIZE * T::size());
+    for (size_t i = start / CHUNK_SIZE; i * CHUNK_SIZE < start + n; i++)
+    {
+        size_t length = min(CHUNK_SIZE, n_shares - i * CHUNK_SIZE);
+        read_raw(buffer.data(), i * CHUNK_SIZE, length);
+        checksums.at(i) = checksum(buffer.data(), length);
+    }
+}
+
+template<class T>
+void ShareTable<T>::read_index()
+{
+    ifstream file(filename + ".index", ios::in | ios::binary);
+    if (file.fail())
+        throw persistence_error("index missing for " + filename);
+    octetStream os;
+    os.input(file);
+    os.get(n_shares);
+    checksums.resize(DIV_CEIL(n_shares, CHUNK_SIZE));
+    for (auto& x : checksums)
+        os.consume(x.data(), x.size());
+}
+
+template<class T>
+void ShareTable<T>::write_index()
+{
+    octetStream os;
+    os.store(n_shares);
+    for (auto& x : checksums)
+        os.append(x.data(), x.size());
+
+    // replace atomically
+    string index = filename + ".index";
+    ofstream file(index + ".tmp", ios::out | ios::binary);
+    os.output(file);
+    file.close();
+    if (file.fail() or rename((index + ".tmp").c_str(), index.c_str()))
+        throw persistence_error("cannot write " + index);
+}
+
+template<class T>
+long ShareTable<T>::read(StackedVector<T>& dest, const vector<int>& regs,
+        size_t vector_size, long start)
+{
+    shared_lock<shared_mutex> l(lock);
+    size_t n = regs.size() * vector_size;
+    if (start < 0 or start + n > n_shares)
+        throw persistence_error(
+                "cannot read " + to_string(n) + " shares from position "
+                        + to_string(start) + " in " + filename + " holding "
+                        + to_string(n_shares));
+
+    if (n > 0)
+    {
+        // whole chunks for checksums
+        size_t first_chunk = start / CHUNK_SIZE;
+        size_t begin = first_chunk * CHUNK_SIZE;
+        size_t end = min<size_t>(DIV_CEIL(start + n, CHUNK_SIZE) * CHUNK_SIZE,
+                n_shares);
+        vector<char> buffer((end - begin) * T::size());
+        read_raw(buffer.data(), begin, end - begin);
+        verify(buffer.data(), first_chunk, end - begin);
+
+        auto it = buffer.data() + (start - begin) * T::size();
+        for (auto& reg : regs)
+            for (size_t j = 0; j < vector_size; j++)
+            {
+                dest[reg + j].assign(it);
+                it += T::size();
+            }
+    }
+
+    size_t res = start + n;
+    return res == n_shares ? -1 : res;
+}
+
+template<class T>
+void ShareTable<T>::write(StackedVector<T>& source, const vector<int>& regs,
+        size_t vector_size, long start)
+{
+    unique_lock<shared_mutex> l(lock);
+    size_t n = regs.size() * vector_size;
+    if (start == -1)
+        start = n_shares;
+    if (start < 0)
+        throw persistence_error("invalid position in " + filename);
+
+    stringstream ss;
+    for (auto& reg : regs)
+        for (size_t j = 0; j < vector_size; j++)
+            source[reg + j].output(ss, false);
+    auto data = ss.str();
+    assert(data.size() == n * T::size());
+
+    size_t old_size = n_shares;
+    if (size_t(start) > n_shares)
+    {
+        // fill with zeros if needed
+        vector<char> zeros((start - n_shares) * T::size());
+        write_raw(zeros.data(), zeros.size(),
+                data_start + n_shares * T::size());
+    }
+    write_raw(data.c_str(), data.size(), data_start + start * T::size());
+
+    n_shares = max(n_shares, start + n);
+    size_t first = min<size_t>(old_size, start);
+    update_checksums(first, start + n - first);
+    write_index();
+}
+
+template<class T>
+string ShareStore<T>::filename(const string& name, int my_num)
+{
+    if (name.empty() or name.find('/') != string::npos)
+        throw persistence_error("invalid table name: '" + name + "'");
+    string dir = "Persistence";
+    mkdir_p(dir.c_str());
+    return dir + "/" + name + "-P" + to_string(my_num) + ".table";
+}
+
+template<class T>
+ShareTable<T>* ShareStore<T>::get(const string& name, int my_num,
+        bool create)
+{
+    lock_guard<mutex> l(lock);
+    auto& table = tables[name];
+    if (not table)
+    {
+        auto fn = filename(name, my_num);
+        if (not create and access(fn.c_str(), F_OK))
+        {
+            tables.erase(name);
+            return 0;
+        }
+        table.reset(new ShareTable<T>(fn, create));
+    }
+    return table.get();
+}
+
+#endif /* PROCESSOR_SHARESTORE_HPP_ */
@@ -0,0 +1,250 @@
+/*
+ * TapeCache.cpp
+ *
+ */
+
+#include "TapeCache.h"
+#include "Program.h"
+#include "Instruction.hpp"
+#include "OnlineOptions.h"
+#include "Tools/octetStream.h"
+#include "Tools/Exceptions.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/filesystem.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#include <string.h>
+
+namespace
+{
+
+const char tag[] = "MPSPDZ-TAPE-CACHE";
+
+struct TapeCacheHeader
+{
+    char tag[sizeof(::tag)];
+    int version;
+    // size and time of the executable that decoded the tape
+    size_t build[2];
+    size_t constants_length;
+    size_t n_instructions, n_args, n_chars;
+};
+
+struct TapeCacheRecord
+{
+    int opcode, size, r[4];
+    size_t n, n_args, n_chars;
+};
+
+size_t padded(size_t length)
+{
+    return (length + 7) / 8 * 8;
+}
+
+}
+
+string TapeCache::get_filename(const string& bytecode_filename)
+{
+    return bytecode_filename.substr(0, bytecode_filename.rfind(".bc"))
+            + ".pbc";
+}
+
+array<size_t, 2> TapeCache::get_build()
+{
+    struct stat st;
+    if (stat("/proc/self/exe", &st))
+        return {};
+    return {{size_t(st.st_size), size_t(st.st_mtime)}};
+}
+
+TapeCache::TapeCache(const string& filename, size_t offset) :
+        filename(filename), offset(offset)
+{
+}
+
+TapeCache* TapeCache::open(const string& bytecode_filename, Program& program)
+{
+    string filename = get_filename(bytecode_filename);
+    if (not boost::filesystem::exists(filename))
+        return 0;
+
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(filename);
+    }
+    catch (exception&)
+    {
+        return 0;
+    }
+
+    TapeCacheHeader header;
+    if (file.size() < sizeof(header))
+        return 0;
+    memcpy(&header, file.data(), sizeof(header));
+    auto build = get_build();
+    if (memcmp(header.tag, tag, sizeof(tag)) or header.version != VERSION
+            or build[0] == 0 or header.build[0] != build[0]
+            or header.build[1] != build[1])
+        return 0;
+
+    size_t offset = sizeof(header) + padded(header.constants_length);
+    if (file.size()
+            != offset + header.n_instructions * sizeof(TapeCacheRecord)
+                    + header.n_args * sizeof(int) + header.n_chars)
+        return 0;
+
+    octetStream os(header.constants_length,
+            (const octet*) file.data() + sizeof(header));
+    string hash;
+    os.get(hash);
+    if (hash != program.hash)
+        return 0;
+
+    for (auto& x : program.max_reg)
+        x = os.get_int(4);
+    for (auto& x : program.max_mem)
+        x = os.get_int(8);
+    for (auto& x : program.min_mem)
+        x = os.get_int(8);
+    program.unknown_usage = os.get_int(1);
+    program.writes_persistence = os.get_int(1);
+    program.offline_data_used.unpack(os);
+    program.n_instructions = header.n_instructions;
+
+    // checks that parsing would run
+    size_t n_requirements = os.get_int(8);
+    for (size_t i = 0; i < n_requirements; i++)
+    {
+        BaseInstruction requirement;
+        requirement.opcode = os.get_int(4);
+        requirement.n = os.get_int(8);
+        requirement.check_requirement();
+    }
+
+    return new TapeCache(filename, offset);
+}
+
+void TapeCache::load(vector<Instruction>& instructions)
+{
+    call_once(loaded, [&]()
+    {
+        boost::iostreams::mapped_file_source file(filename);
+        TapeCacheHeader header;
+        memcpy(&header, file.data(), sizeof(header));
+
+        auto records = (const TapeCacheRecord*) (file.data() + offset);
+        auto args = (const int*) (records + header.n_instructions);
+        auto chars = (const char*) (args + header.n_args);
+
+        instructions.resize(header.n_instructions);
+        for (auto& instruction : instructions)
+        {
+            auto& record = *records++;
+            instruction.opcode = record.opcode;
+            instruction.size = record.size;
+            memcpy(instruction.r, record.r, sizeof(record.r));
+            instruction.n = record.n;
+            instruction.start.assign(args, args + record.n_args);
+            args += record.n_args;
+            instruction.str.assign(chars, record.n_chars);
+            chars += record.n_chars;
+        }
+    });
+}
+
+void TapeCache::write(const string& bytecode_filename, const Program& program)
+{
+    if (program.size() < MIN_SIZE)
+        return;
+
+    TapeCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.tag, tag, sizeof(tag));
+    header.version = VERSION;
+    auto build = get_build();
+    if (build[0] == 0)
+        return;
+    memcpy(header.build, build.data(), sizeof(header.build));
+
+    octetStream os;
+    os.store(program.hash);
+    for (auto& x : program.max_reg)
+        os.store_int(x, 4);
+    for (auto& x : program.max_mem)
+        os.store_int(x, 8);
+    for (auto& x : program.min_mem)
+        os.store_int(x, 8);
+    os.store_int(program.unknown_usage, 1);
+    os.store_int(program.writes_persistence, 1);
+    program.offline_data_used.pack(os);
+
+    vector<const Instruction*> requirements;
+    for (auto& instruction : program.p)
+        switch (instruction.opcode)
+        {
+        case REQBL:
+        case GREQBL:
+        case ACTIVE:
+            requirements.push_back(&instruction);
+        }
+    os.store_int(requirements.size(), 8);
+    for (auto requirement : requirements)
+    {
+        os.store_int(requirement->opcode, 4);
+        os.store_int(requirement->n, 8);
+    }
+    header.constants_length = os.get_length();
+
+    vector<TapeCacheRecord> records;
+    vector<int> args;
+    string chars;
+    for (auto& instruction : program.p)
+    {
+        records.push_back({});
+        auto& record = records.back();
+        record.opcode = instruction.opcode;
+        record.size = instruction.size;
+        memcpy(record.r, instruction.r, sizeof(record.r));
+        record.n = instruction.n;
+        record.n_args = instruction.start.size();
+        record.n_chars = instruction.str.size();
+        args.insert(args.end(), instruction.start.begin(),
+                instruction.start.end());
+        chars += instruction.str;
+    }
+    header.n_instructions = records.size();
+    header.n_args = args.size();
+    header.n_chars = chars.size();
+
+    // avoid other processes reading a partial file
+    string filename = get_filename(bytecode_filename);
+    string tmp = filename + ".tmp" + to_string(getpid());
+    ofstream file(tmp, ios::binary);
+    file.write((char*) &header, sizeof(header));
+    file.write((char*) os.get_data(), os.get_length());
+    string padding(padded(os.get_length()) - os.get_length(), 0);
+    file << padding;
+    file.write((char*) records.data(), records.size() * sizeof(records[0]));
+    file.write((char*) args.data(), args.size() * sizeof(int));
+    file << chars;
+    file.close();
+
+    try
+    {
+        if (not file.good())
+            throw file_error(tmp);
+        boost::filesystem::rename(tmp, filename);
+    }
+    catch (exception& e)
+    {
+        // the cache is optional
+        boost::system::error_code ec;
+        boost::filesystem::remove(tmp, ec);
+        if (OnlineOptions::singleton.verbose)
+            cerr << "Cannot write tape cache " << filename << ": " << e.what()
+                    << endl;
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * TapeCache.h
+ *
+ */
+
+#ifndef PROCESSOR_TAPECACHE_H_
+#define PROCESSOR_TAPECACHE_H_
+
+#include "Instruction.h"
+
+#include <mutex>
+
+class Program;
+
+/**
+ * Predecoded tape next to the bytecode (``.pbc``),
+ * valid for the same bytecode hash and virtual machine executable.
+ * The constants of a program are read immediately,
+ * and the instructions are only decoded when first needed.
+ */
+class TapeCache
+{
+    static const int VERSION = 2;
+
+    // smaller tapes are parsed quickly enough
+    static const size_t MIN_SIZE = 100000;
+
+    string filename;
+    size_t offset;
+    once_flag loaded;
+
+    static string get_filename(const string& bytecode_filename);
+    static array<size_t, 2> get_build();
+
+public:
+    // null if there is no valid cache
+    static TapeCache* open(const string& bytecode_filename, Program& program);
+    static void write(const string& bytecode_filename, const Program& program);
+
+    TapeCache(const string& filename, size_t offset);
+
+    // thread-safe
+    void load(vector<Instruction>& instructions);
+};
+
+#endif /* PROCESSOR_TAPECACHE_H_ */
@@ -349,6 +349,8 @@
     X(RUN_TAPE, throw not_implemented(),) \
     X(JOIN_TAPE, throw not_implemented(),) \
     X(CRASH, throw not_implemented(),) \
+    X(INITCHUNKS, throw not_implemented(),) \
+    X(NEXTCHUNK, throw not_implemented(),) \
     X(STARTGRIND, throw not_implemented(),) \
     X(STOPGRIND, throw not_implemented(),) \
     X(NPLAYERS, throw not_implemented(),) \
@@ -366,6 +368,8 @@
     X(WRITESOCKETSHARE, throw not_implemented(),) \
     X(WRITEFILESHARE, throw not_implemented(),) \
     X(READFILESHARE, throw not_implemented(),) \
+    X(WRITETABLESHARE, throw not_implemented(),) \
+    X(READTABLESHARE, throw not_implemented(),) \
     X(PUBINPUT, throw not_implemented(),) \
     X(RAWOUTPUT, throw not_implemented(),) \
     X(INTOUTPUT, throw not_implemented(),) \
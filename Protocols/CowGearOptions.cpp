@@ -24,6 +24,7 @@ CowGearOptions::CowGearOptions(bool covert)
     }
 
     use_top_gear = false;
+    proof_threads = 1;
 }
 
 CowGearOptions::CowGearOptions(ez::ezOptionParser& opt, int argc,
@@ -70,6 +71,15 @@ CowGearOptions::CowGearOptions(ez::ezOptionParser& opt, int argc,
             "-J", // Flag token.
             "--no-top-gear" // Flag token.
     );
+    opt.add(
+            to_string(proof_threads).c_str(), // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            ("Number of threads per zero-knowledge proof (default: "
+                    + to_string(proof_threads) + ")").c_str(), // Help description.
+            "--proof-threads" // Flag token.
+    );
     opt.parse(argc, argv);
     if (opt.isSet("-c"))
         opt.get("-c")->getInt(covert_security);
@@ -79,6 +89,12 @@ CowGearOptions::CowGearOptions(ez::ezOptionParser& opt, int argc,
         exit(1);
     }
     use_top_gear = not opt.isSet("-J");
+    opt.get("--proof-threads")->getInt(proof_threads);
+    if (proof_threads < 1)
+    {
+        cerr << "Invalid number of proof threads: " << proof_threads << endl;
+        exit(1);
+    }
     if (opt.isSet("-T"))
         cerr << "WARNING: Option -T/--top-gear is obsolete "
             "because it is the default now. Use -J to deactivate it." << endl;
@@ -16,6 +16,7 @@ public:
     static CowGearOptions singleton;
 
     int covert_security;
+    int proof_threads;
 
     CowGearOptions(bool covert = true);
     CowGearOptions(ez::ezOptionParser& opt, int argc, const char** argv,
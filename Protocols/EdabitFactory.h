@@ -0,0 +1,81 @@
+/*
+ * EdabitFactory.h
+ *
+ */
+
+#ifndef PROTOCOLS_EDABITFACTORY_H_
+#define PROTOCOLS_EDABITFACTORY_H_
+
+#include "edabit.h"
+#include "dabit.h"
+#include "Processor/Data_Files.h"
+#include "Networking/Player.h"
+#include "Tools/time-func.h"
+
+#include <deque>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+template<class T> class BufferPrep;
+
+/**
+ * Generates daBits and edaBits for one online thread in the background.
+ * The worker runs separate preprocessing with its own player.
+ * Every batch taken online is replaced by a new one, so
+ * all parties generate the same sequence of batches.
+ */
+template<class T>
+class EdabitFactory
+{
+public:
+    // (strict, n_bits) with length 0 for daBits
+    typedef pair<bool, int> key_type;
+    typedef function<void(EdabitFactory<T>&)> setup_type;
+
+private:
+    int depth;
+    set<key_type> declared;
+    deque<key_type> orders;
+    map<key_type, deque<vector<edabitvec<T>>>> edabits;
+    deque<vector<dabit<T>>> dabits;
+    bool stopping;
+    string error;
+
+    mutex lock;
+    condition_variable cond;
+    thread worker;
+
+    void order(const key_type& key);
+
+    deque<vector<edabitvec<T>>>& get_ready(const key_type& key, edabitvec<T>*)
+    { return edabits[key]; }
+    deque<vector<dabit<T>>>& get_ready(const key_type&, dabit<T>*)
+    { return dabits; }
+
+    template<class U>
+    void take(vector<U>& res, const key_type& key, DataPositions& usage);
+
+public:
+    Timer timer;
+    NamedCommStats comm;
+
+    EdabitFactory(int depth, setup_type setup);
+    ~EdabitFactory();
+
+    void declare(const DataPositions& usage);
+    bool serves(const key_type& key);
+
+    void take(vector<edabitvec<T>>& res, bool strict, int n_bits,
+            DataPositions& usage);
+    void take(vector<dabit<T>>& res, DataPositions& usage);
+
+    // to be called by the setup function in the worker thread
+    void serve(BufferPrep<T>& prep, function<void()> check);
+
+    void stop();
+};
+
+#endif /* PROTOCOLS_EDABITFACTORY_H_ */
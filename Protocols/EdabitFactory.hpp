@@ -0,0 +1,155 @@
+/*
+ * EdabitFactory.hpp
+ *
+ */
+
+#ifndef PROTOCOLS_EDABITFACTORY_HPP_
+#define PROTOCOLS_EDABITFACTORY_HPP_
+
+#include "EdabitFactory.h"
+#include "ReplicatedPrep.h"
+
+template<class T>
+EdabitFactory<T>::EdabitFactory(int depth, setup_type setup) :
+        depth(depth), stopping(false)
+{
+    assert(depth > 0);
+    worker = thread([this, setup]()
+    {
+        try
+        {
+            setup(*this);
+        }
+        catch (exception& e)
+        {
+            lock_guard<mutex> l(lock);
+            error = e.what();
+            cond.notify_all();
+        }
+    });
+}
+
+template<class T>
+EdabitFactory<T>::~EdabitFactory()
+{
+    stop();
+}
+
+template<class T>
+void EdabitFactory<T>::order(const key_type& key)
+{
+    if (declared.insert(key).second)
+    {
+        for (int i = 0; i < depth; i++)
+            orders.push_back(key);
+        cond.notify_all();
+    }
+}
+
+template<class T>
+void EdabitFactory<T>::declare(const DataPositions& usage)
+{
+    lock_guard<mutex> l(lock);
+    for (auto& x : usage.edabits)
+        if (x.second > 0)
+            order(x.first);
+    if (usage.files[DATA_INT][DATA_DABIT] > 0)
+        order({false, 0});
+}
+
+template<class T>
+bool EdabitFactory<T>::serves(const key_type& key)
+{
+    lock_guard<mutex> l(lock);
+    return declared.count(key);
+}
+
+template<class T>
+template<class U>
+void EdabitFactory<T>::take(vector<U>& res, const key_type& key,
+        DataPositions& usage)
+{
+    unique_lock<mutex> l(lock);
+    auto& ready = get_ready(key, (U*) 0);
+    // replacement in any case to keep the parties in sync
+    orders.push_back(key);
+    cond.notify_all();
+    bool waited = ready.empty();
+    cond.wait(l, [&]() { return not ready.empty() or not error.empty(); });
+    if (not error.empty())
+        throw runtime_error("background preprocessing failed: " + error);
+    res = std::move(ready.front());
+    ready.pop_front();
+    usage.count_prefetched(key.first, key.second, waited);
+}
+
+template<class T>
+void EdabitFactory<T>::take(vector<edabitvec<T>>& res, bool strict,
+        int n_bits, DataPositions& usage)
+{
+    take(res, {strict, n_bits}, usage);
+}
+
+template<class T>
+void EdabitFactory<T>::take(vector<dabit<T>>& res, DataPositions& usage)
+{
+    take(res, {false, 0}, usage);
+}
+
+template<class T>
+void EdabitFactory<T>::serve(BufferPrep<T>& prep, function<void()> check)
+{
+    unique_lock<mutex> l(lock);
+    while (true)
+    {
+        cond.wait(l, [this]() { return stopping or not orders.empty(); });
+        // finish orders that the other parties process as well
+        if (orders.empty())
+            break;
+        auto key = orders.front();
+        orders.pop_front();
+        l.unlock();
+
+        vector<edabitvec<T>> new_edabits;
+        vector<dabit<T>> new_dabits;
+        timer.start();
+        if (key.second == 0)
+        {
+            prep.buffer_dabits(0);
+            swap(new_dabits, prep.dabits);
+            assert(not new_dabits.empty());
+        }
+        else
+        {
+            prep.buffer_edabits(key.first, key.second, 0);
+            swap(new_edabits, prep.edabits[key]);
+            assert(not new_edabits.empty());
+        }
+        // has to happen before using anything online
+        check();
+        timer.stop();
+
+        l.lock();
+        if (key.second == 0)
+            get_ready(key, (dabit<T>*) 0).push_back(std::move(new_dabits));
+        else
+            get_ready(key, (edabitvec<T>*) 0).push_back(
+                    std::move(new_edabits));
+        cond.notify_all();
+    }
+}
+
+template<class T>
+void EdabitFactory<T>::stop()
+{
+    if (not worker.joinable())
+        return;
+    {
+        lock_guard<mutex> l(lock);
+        stopping = true;
+    }
+    cond.notify_all();
+    worker.join();
+}
+
+#endif /* PROTOCOLS_EDABITFACTORY_HPP_ */
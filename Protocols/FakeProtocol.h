@@ -362,6 +362,39 @@ public:
                 }
             }
         }
+        else if (tag == "ArgM")
+        {
+            auto& S = processor.get_S();
+            for (size_t i = 0; i < args.size(); i += args[i])
+            {
+                assert(i + args[i] <= args.size());
+                assert(args[i] >= 7);
+                int k = args[i + 3];
+                bool maximum = args[i + 4];
+                for (int j = 0; j < args[i + 1]; j++)
+                {
+                    // same tournament as the compiled version
+                    vector<pair<int, T>> entries;
+                    for (int l = 5; l < args[i]; l++)
+                        entries.push_back({l - 5, S[args[i + l] + j]});
+                    while (entries.size() > 1)
+                    {
+                        vector<pair<int, T>> next;
+                        for (size_t l = 0; l + 1 < entries.size(); l += 2)
+                        {
+                            auto& a = entries[l];
+                            auto& b = entries[l + 1];
+                            bool less = T(b.second - a.second).get_bit(k);
+                            next.push_back(less != maximum ? b : a);
+                        }
+                        if (entries.size() % 2)
+                            next.push_back(entries.back());
+                        entries = next;
+                    }
+                    S[args[i + 2] + j] = entries[0].first;
+                }
+            }
+        }
         else
             throw runtime_error("unknown CISC instruction: " + tag);
     }
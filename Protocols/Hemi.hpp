@@ -12,6 +12,7 @@
 #include "MatrixFile.h"
 #include "DummyMatrixPrep.h"
 #include "Processor/Conv2dTuple.h"
+#include "Tools/ScratchVector.h"
 
 #include "HemiMatrixPrep.hpp"
 #include "HemiPrep.hpp"
@@ -96,11 +97,13 @@ bool Hemi<T>::use_plain_matmul(const array<int, 3> dim, SubProcessor<T>& process
     int requirement = BaseMachine::matrix_requirement(dim[0], dim[1], dim[2]);
 
     if (OnlineOptions::singleton.has_option("verbose_matrix"))
-        fprintf(stderr, "savings=%d minimum_batch=%d requirement=%d\n", savings,
-                prep.minimum_batch(), requirement);
+        fprintf(stderr, "savings=%d full_batch=%d requirement=%d\n", savings,
+                prep.full_batch(), requirement);
 
+    // compare to the full batch because the plan might shrink the
+    // batch to the requirement
     return HemiOptions::singleton.plain_matmul
-            or prep.minimum_batch() / savings > requirement;
+            or prep.full_batch() / savings > requirement;
 }
 
 template<class T>
@@ -109,7 +112,7 @@ void Hemi<T>::matmulsm(SubProcessor<T>& processor, MemoryPart<T>& source,
 {
     auto& dim = instruction.get_start();
 
-    vector<int> plain_args, complex_args;
+    ScratchVector<int> plain_args, complex_args;
 
     for (auto it = dim.begin(); it < dim.end(); it += 12)
     {
@@ -148,10 +151,19 @@ void Hemi<T>::matmulsm(SubProcessor<T>& processor, MemoryPart<T>& source,
 
         assert(C + resultNumberOfRows * resultNumberOfColumns <= S.end());
 
-        ShareMatrix<T> A(resultNumberOfRows, usedNumberOfFirstFactorColumns), B(usedNumberOfFirstFactorColumns, resultNumberOfColumns);
+        // reuse the storage of earlier factors
+        ShareMatrix<T> A, B;
+        ScratchVector<T> A_entries, B_entries;
+        A.entries.v.swap(A_entries);
+        B.entries.v.swap(B_entries);
+        A.reset(resultNumberOfRows, usedNumberOfFirstFactorColumns);
+        B.reset(usedNumberOfFirstFactorColumns, resultNumberOfColumns);
+
         if (not T::real_shares(processor.P))
         {
             matrix_multiply(A, B, processor);
+            A.entries.v.swap(A_entries);
+            B.entries.v.swap(B_entries);
             return;
         }
 
@@ -176,6 +188,8 @@ void Hemi<T>::matmulsm(SubProcessor<T>& processor, MemoryPart<T>& source,
         }
 
         auto res = matrix_multiply(A, B, processor);
+        A.entries.v.swap(A_entries);
+        B.entries.v.swap(B_entries);
 
         for (int i = 0; i < resultNumberOfRows; i++)
             for (int j = 0; j < resultNumberOfColumns; j++)
@@ -22,28 +22,29 @@ class HemiMatrixPrep : public BufferPrep<ShareMatrix<T>>
 
     int n_rows, n_inner, n_cols;
     bool swapped;
+    int n_matrices;
 
     LivePrep* prep;
 
     HemiMatrixPrep(const HemiMatrixPrep&) = delete;
 
+    void plan();
+
 public:
     static const bool homomorphic = true;
 
     HemiMatrixPrep(int n_rows, int n_inner, int n_cols, LivePrep& prep,
             DataPositions& usage) :
             super(usage), n_rows(n_rows), n_inner(n_inner),
-            n_cols(n_cols), prep(&prep)
+            n_cols(n_cols), swapped(false), n_matrices(0), prep(&prep)
     {
-        swapped = n_rows > n_cols;
-        if (swapped)
-            std::swap(this->n_rows, this->n_cols);
-        assert(this->n_cols >= this->n_rows);
         assert(prep.proc);
         this->P = &prep.proc->P;
     }
 
     int minimum_batch();
+    // number of products when filling all slots
+    int full_batch();
 
     void set_protocol(typename ShareMatrix<T>::Protocol&)
     {
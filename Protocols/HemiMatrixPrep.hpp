@@ -89,11 +89,62 @@ inline void matrix_rand_mult(ThreadJob, false_type)
     throw not_implemented();
 }
 
+template<class T>
+void HemiMatrixPrep<T>::plan()
+{
+    if (n_matrices)
+        return;
+
+    assert(prep);
+    int n_slots = prep->get_FTD().num_slots();
+    int requirement = BaseMachine::matrix_requirement(n_rows, n_inner, n_cols);
+    int small = min(n_rows, n_cols), large = max(n_rows, n_cols);
+
+    // The cost is the number of ciphertext-plaintext multiplications,
+    // which is the number of groups times the dimension not in slots.
+    // Putting the smaller dimension in slots allows the most matrices
+    // per batch, but it wastes work if fewer are needed.
+    int batch = n_slots / small;
+    bool small_in_slots = true;
+    if (batch > 0 and (requirement < 0 or requirement >= batch))
+        n_matrices = batch;
+    else
+    {
+        n_matrices = batch ? max(requirement, 1) : 1;
+        long cost_small = large
+                * Diagonalizer::n_groups(small, n_matrices, n_slots);
+        long cost_large = small
+                * Diagonalizer::n_groups(large, n_matrices, n_slots);
+        small_in_slots = cost_small <= cost_large;
+    }
+
+    swapped = (n_rows > n_cols) == small_in_slots;
+    if (swapped)
+        std::swap(n_rows, n_cols);
+
+    if (OnlineOptions::singleton.has_option("verbose_he"))
+    {
+        fprintf(stderr, "packing %d %dx%d * %dx%d products in %zu groups "
+                "(requirement %d)\n", n_matrices, n_rows, n_inner, n_inner,
+                n_cols,
+                Diagonalizer::n_groups(n_rows, n_matrices, n_slots),
+                requirement);
+        fflush(stderr);
+    }
+}
+
 template<class T>
 int HemiMatrixPrep<T>::minimum_batch()
+{
+    plan();
+    return n_matrices;
+}
+
+template<class T>
+int HemiMatrixPrep<T>::full_batch()
 {
     assert(prep);
-    return prep->get_FTD().num_slots() / n_rows;
+    return max(1, prep->get_FTD().num_slots() / min(n_rows, n_cols));
 }
 
 template<class T>
@@ -103,7 +154,8 @@ void HemiMatrixPrep<T>::buffer_triples()
     auto& multipliers = prep->get_multipliers();
     auto& FTD = prep->get_FTD();
     auto& pk = prep->get_pk();
-    int n_matrices = minimum_batch();
+    plan();
+    int n_matrices = this->n_matrices;
 
     if (OnlineOptions::singleton.has_option("verbose_he"))
     {
@@ -119,7 +171,7 @@ void HemiMatrixPrep<T>::buffer_triples()
     AddableVector<ValueMatrix<gfpvar>> C(n_matrices);
     MatrixRandMultJob job(C, A, B, T::local_mul);
 
-    if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton())
+    if (BaseMachine::is_main_thread() and BaseMachine::has_singleton())
     {
         auto& queues = BaseMachine::s().queues;
         int start = queues.distribute(job, n_matrices);
@@ -142,8 +194,9 @@ void HemiMatrixPrep<T>::buffer_triples()
 #endif
 
     Diagonalizer diag(A, FTD, pk);
+    int n_groups = diag.n_groups();
 
-    vector<Plaintext_<FFT_Data>> products(n_cols, FTD);
+    vector<Plaintext_<FFT_Data>> products(n_groups * n_cols, FTD);
     assert(prep->proc);
     auto& P = prep->proc->P;
 
@@ -166,23 +219,37 @@ void HemiMatrixPrep<T>::buffer_triples()
         TreeSum<Ciphertext>().run(others_ct[0], P);
     }
 
+    // ciphertexts per multiplier and group of rows
+    vector<vector<vector<Ciphertext>>> factors;
+    for (auto m : multipliers)
+    {
+        auto& multiplicands = m->get_multiplicands(others_ct, pk);
+        factors.push_back({});
+        for (int g = 0; g < n_groups; g++)
+            factors.back().push_back(
+                    {multiplicands.begin() + g * n_inner,
+                            multiplicands.begin() + (g + 1) * n_inner});
+    }
+
+    for (int g = 0; g < n_groups; g++)
     for (int j = 0; j < n_cols; j++)
-        for (auto m : multipliers)
+        for (size_t k = 0; k < multipliers.size(); k++)
         {
+            auto m = multipliers[k];
 #ifdef VERBOSE_HE
-            fprintf(stderr, "column %d with party offset %d at %f\n", j,
-                    m->get_offset(), timer.elapsed());
+            fprintf(stderr, "group %d column %d with party offset %d at %f\n",
+                    g, j, m->get_offset(), timer.elapsed());
             fflush(stderr);
 #endif
             Ciphertext C(pk);
-            auto& multiplicands = m->get_multiplicands(others_ct, pk);
-            if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton())
+            auto& multiplicands = factors[k][g];
+            if (BaseMachine::is_main_thread() and BaseMachine::has_singleton())
             {
                 auto& queues = BaseMachine::s().queues;
                 vector<Ciphertext> products(n_inner, pk);
                 vector<Plaintext_<FFT_Data>> multiplicands2;
                 for (int i = 0; i < n_inner; i++)
-                    multiplicands2.push_back(diag.get_plaintext(B, i, j));
+                    multiplicands2.push_back(diag.get_plaintext(B, i, j, g));
                 CipherPlainMultJob job(products, multiplicands, multiplicands2, true);
                 int start = queues.distribute(job, n_inner);
 #ifdef VERBOSE_HE
@@ -202,14 +269,14 @@ void HemiMatrixPrep<T>::buffer_triples()
             }
             else
                 for (int i = 0; i < n_inner; i++)
-                    C += multiplicands.at(i) * diag.get_plaintext(B, i, j);
+                    C += multiplicands.at(i) * diag.get_plaintext(B, i, j, g);
 
 #ifdef VERBOSE_HE
             fprintf(stderr, "adding column %d with party offset %d at %f\n", j,
                     m->get_offset(), timer.elapsed());
             fflush(stderr);
 #endif
-            m->add(products[j], C, BOTH, n_inner);
+            m->add(products[g * n_cols + j], C, BOTH, n_inner);
         }
 
     if (T::local_mul)
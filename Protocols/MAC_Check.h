@@ -16,7 +16,7 @@ using namespace std;
 
 
 /* The MAX number of things we will partially open before running
- * a MAC Check
+ * a MAC Check unless a budget is given with --mac-check-budget
  *
  * Keep this at much less than 1MB of data to be able to cope with
  * multi-threaded players
@@ -87,11 +87,16 @@ class Tree_MAC_Check : public TreeSum<typename U::open_type>, public MAC_Check_B
   vector<typename U::mac_type> macs;
   vector<T> vals;
 
+  // number of values to accumulate before checking
+  size_t check_threshold;
+
   void AddToValues(vector<T>& values);
   void CheckIfNeeded(const Player& P);
   int WaitingForCheck()
     { return max(macs.size(), vals.size()); }
 
+  void count_check();
+
   public:
 
   static void setup(Player& P);
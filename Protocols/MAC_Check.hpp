@@ -69,6 +69,12 @@ Tree_MAC_Check<U>::Tree_MAC_Check(const typename U::mac_key_type::Scalar& ai, in
 {
   popen_cnt=0;
   this->alphai=ai;
+
+  check_threshold = POPEN_MAX;
+  int budget = OnlineOptions::singleton.mac_check_budget;
+  if (budget > 0)
+    check_threshold = max(1., budget * 1e6 /
+        (T::size() + U::mac_type::size()));
 }
 
 template<class T>
@@ -128,10 +134,43 @@ void Tree_MAC_Check<U>::AddToValues(vector<T>& values)
 template<class T>
 void Tree_MAC_Check<T>::CheckIfNeeded(const Player& P)
 {
-  if (WaitingForCheck() >= POPEN_MAX)
+  if (size_t(WaitingForCheck()) >= check_threshold)
     Check(P);
 }
 
+template<class T>
+void Tree_MAC_Check<T>::count_check()
+{
+  this->checks++;
+  this->values_checked += popen_cnt;
+}
+
+/*
+ * Random linear combination of values and MACs.
+ * The coefficients are generated per block to keep the inner loop free
+ * of PRNG calls, in the same order as element-wise generation.
+ */
+template<class T, class U, class V, class W>
+void mac_combine(T& values_sum, T& macs_sum, const V* vals, const W* macs,
+    size_t n, PRNG& G)
+{
+  const size_t block_size = 1024;
+  vector<U> coeffs(min(n, block_size));
+  for (size_t start = 0; start < n; start += block_size)
+    {
+      size_t m = min(block_size, n - start);
+      for (size_t i = 0; i < m; i++)
+        coeffs[i].almost_randomize(G);
+      auto x = vals + start;
+      auto y = macs + start;
+      for (size_t i = 0; i < m; i++)
+        {
+          values_sum += x[i] * coeffs[i];
+          macs_sum += coeffs[i] * y[i];
+        }
+    }
+}
+
 
 template <class U>
 void Tree_MAC_Check<U>::AddToCheck(const U& share, const T& value, const Player& P)
@@ -161,6 +200,8 @@ void MAC_Check_<U>::Check(const Player& P)
   assert(int(macs.size()) <= popen_cnt);
   assert(this->coordinator);
 
+  this->count_check();
+
   if (popen_cnt < 10)
     {
       // no random combination with few values
@@ -193,19 +234,10 @@ void MAC_Check_<U>::Check(const Player& P)
       PRNG G;
       G.SetSeed(seed);
 
-      U sj;
       typename U::mac_type a,gami,temp;
-      typename U::mac_type::Scalar h;
       vector<typename U::mac_type> tau(P.num_players());
-      for (int i=0; i<popen_cnt; i++)
-        {
-          h.almost_randomize(G);
-          temp = vals[i] * h;
-          a = (a + temp);
-
-          temp = h * macs[i];
-          gami = (gami + temp);
-        }
+      mac_combine<typename U::mac_type, typename U::mac_type::Scalar>(a, gami,
+          vals.data(), macs.data(), popen_cnt, G);
 
       temp = this->alphai * a;
       tau[P.my_num()] = (gami - temp);
@@ -297,25 +329,32 @@ void MAC_Check_Z2k<T, U, V, W>::Check(const Player& P)
   cout << "Checking " << shares[0] << " " << this->vals[0] << " " << this->macs[0] << endl;
 #endif
 
+  this->count_check();
+
   octet seed[SEED_SIZE];
   Create_Random_Seed(seed,P,SEED_SIZE);
   PRNG G;
   G.SetSeed(seed);
 
+  // reduction modulo 2^(K+S) only at the end
   T y, mj;
   y.assign_zero();
   mj.assign_zero();
-  vector<U> chi;
-  for (int i = 0; i < this->popen_cnt; ++i)
+  const int block_size = 1024;
+  vector<U> chi(min(this->popen_cnt, block_size));
+  for (int start = 0; start < this->popen_cnt; start += block_size)
   {
-    U temp_chi;
-    temp_chi.randomize(G);
-    T xi = this->vals[i];
-    y += xi * temp_chi;
-    T mji = this->macs[i];
-    mj += temp_chi * mji;
-    chi.push_back(temp_chi);
+    int m = min(block_size, this->popen_cnt - start);
+    U::randomize_many(chi.data(), m, G);
+    for (int i = 0; i < m; ++i)
+    {
+      T chi_i = chi[i];
+      y = y.lazy_add(T(this->vals[start + i]).lazy_mul(chi_i));
+      mj = mj.lazy_add(T(this->macs[start + i]).lazy_mul(chi_i));
+    }
   }
+  y.normalize();
+  mj.normalize();
 
   T zj = mj - this->alphai * y;
   vector<T> zjs(P.num_players());
@@ -32,12 +32,13 @@ protected:
 
 public:
     size_t values_opened;
+    size_t checks, values_checked;
 
     static void setup(Player&) {}
     static void teardown() {}
 
     MAC_Check_Base(const typename T::mac_key_type::Scalar& mac_key = { }) :
-            alphai(mac_key), values_opened(0) {}
+            alphai(mac_key), values_opened(0), checks(0), values_checked(0) {}
     virtual ~MAC_Check_Base() {}
 
     /// Run checking protocol
@@ -0,0 +1,97 @@
+/*
+ * PrepService.h
+ *
+ */
+
+#ifndef PROTOCOLS_PREPSERVICE_H_
+#define PROTOCOLS_PREPSERVICE_H_
+
+#include "edabit.h"
+#include "dabit.h"
+#include "Networking/Player.h"
+
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+template<class T> class BufferPrep;
+
+/**
+ * Process-wide preprocessing shared by all online threads.
+ * Every type (triples, bits, daBits, edaBits per length) is generated
+ * by its own worker threads with separate players once requested.
+ * The first party decides which online thread gets which batch,
+ * so all parties use the same batches in the same place.
+ */
+template<class T>
+class PrepService
+{
+public:
+    enum kind_type
+    {
+        TRIPLES, BITS, DABITS, EDABITS
+    };
+
+    // kind, strict, length
+    typedef array<int, 3> key_type;
+    typedef function<void(PrepService<T>&, const key_type&, int)> setup_type;
+
+    struct Batch
+    {
+        vector<array<T, 3>> triples;
+        vector<T> bits;
+        vector<dabit<T>> dabits;
+        vector<edabitvec<T>> edabits;
+    };
+
+private:
+    struct Queue
+    {
+        map<long, Batch> ready;
+        long assigned, consumed;
+        vector<thread> workers;
+
+        Queue() : assigned(0), consumed(0) {}
+    };
+
+    int n_workers;
+    int depth;
+    setup_type setup;
+    map<key_type, Queue> queues;
+    // batches ready and waited for by online thread
+    map<int, map<key_type, array<long long, 2>>> stats;
+    bool stopping;
+    string error;
+
+    mutex lock;
+    condition_variable cond;
+
+    Queue& get_queue(const key_type& key);
+    void take(Batch& res, const key_type& key, Player& P);
+
+    static string name(const key_type& key);
+
+public:
+    NamedCommStats comm;
+
+    static string player_name(const key_type& key, int worker);
+
+    PrepService(int n_workers, setup_type setup);
+    ~PrepService();
+
+    void take(vector<array<T, 3>>& res, Player& P);
+    void take(vector<T>& res, Player& P);
+    void take(vector<dabit<T>>& res, Player& P);
+    void take(vector<edabitvec<T>>& res, bool strict, int n_bits, Player& P);
+
+    // to be called by the setup function in the worker thread
+    void serve(BufferPrep<T>& prep, Player& P, function<void()> check,
+            const key_type& key, int worker);
+
+    void stop();
+    void print_stats();
+};
+
+#endif /* PROTOCOLS_PREPSERVICE_H_ */
@@ -0,0 +1,242 @@
+/*
+ * PrepService.hpp
+ *
+ */
+
+#ifndef PROTOCOLS_PREPSERVICE_HPP_
+#define PROTOCOLS_PREPSERVICE_HPP_
+
+#include "PrepService.h"
+#include "ReplicatedPrep.h"
+#include "Processor/BaseMachine.h"
+
+template<class T>
+PrepService<T>::PrepService(int n_workers, setup_type setup) :
+        n_workers(n_workers), depth(2 * n_workers), setup(setup),
+        stopping(false)
+{
+    assert(n_workers > 0);
+}
+
+template<class T>
+PrepService<T>::~PrepService()
+{
+    stop();
+}
+
+template<class T>
+string PrepService<T>::name(const key_type& key)
+{
+    switch (key[0])
+    {
+    case TRIPLES:
+        return "triples";
+    case BITS:
+        return "bits";
+    case DABITS:
+        return "daBits";
+    case EDABITS:
+        return string(key[1] ? "strict " : "") + "edaBits of length "
+                + to_string(key[2]);
+    default:
+        throw runtime_error("unknown preprocessing type");
+    }
+}
+
+template<class T>
+string PrepService<T>::player_name(const key_type& key, int worker)
+{
+    return "prep-" + to_string(key[0]) + "-" + to_string(key[1]) + "-"
+            + to_string(key[2]) + "-" + to_string(worker);
+}
+
+template<class T>
+typename PrepService<T>::Queue& PrepService<T>::get_queue(const key_type& key)
+{
+    auto& queue = queues[key];
+    if (queue.workers.empty() and not stopping)
+        for (int i = 0; i < n_workers; i++)
+            queue.workers.push_back(thread([this, key, i]()
+            {
+                try
+                {
+                    setup(*this, key, i);
+                }
+                catch (exception& e)
+                {
+                    lock_guard<mutex> l(lock);
+                    error = e.what();
+                    cond.notify_all();
+                }
+            }));
+    return queue;
+}
+
+template<class T>
+void PrepService<T>::take(Batch& res, const key_type& key, Player& P)
+{
+    long seq = 0;
+    {
+        lock_guard<mutex> l(lock);
+        auto& queue = get_queue(key);
+        if (P.my_num() == 0)
+            seq = queue.assigned++;
+    }
+
+    // the batch order depends on thread scheduling
+    octetStream os;
+    if (P.my_num() == 0)
+    {
+        os.store_int(seq, 8);
+        P.send_all(os);
+    }
+    else
+    {
+        P.receive_player(0, os);
+        seq = os.get_int(8);
+    }
+
+    unique_lock<mutex> l(lock);
+    auto& queue = queues[key];
+    auto& ready = queue.ready;
+    bool waited = not ready.count(seq);
+    cond.wait(l, [&]() { return ready.count(seq) or not error.empty(); });
+    if (not error.empty())
+        throw runtime_error("shared preprocessing failed: " + error);
+    res = std::move(ready[seq]);
+    ready.erase(seq);
+    queue.consumed++;
+    stats[BaseMachine::thread_num][key][waited]++;
+    cond.notify_all();
+}
+
+template<class T>
+void PrepService<T>::take(vector<array<T, 3>>& res, Player& P)
+{
+    Batch batch;
+    take(batch, {{TRIPLES, 0, 0}}, P);
+    res = std::move(batch.triples);
+}
+
+template<class T>
+void PrepService<T>::take(vector<T>& res, Player& P)
+{
+    Batch batch;
+    take(batch, {{BITS, 0, 0}}, P);
+    res = std::move(batch.bits);
+}
+
+template<class T>
+void PrepService<T>::take(vector<dabit<T>>& res, Player& P)
+{
+    Batch batch;
+    take(batch, {{DABITS, 0, 0}}, P);
+    res = std::move(batch.dabits);
+}
+
+template<class T>
+void PrepService<T>::take(vector<edabitvec<T>>& res, bool strict, int n_bits,
+        Player& P)
+{
+    Batch batch;
+    take(batch, {{EDABITS, strict, n_bits}}, P);
+    res = std::move(batch.edabits);
+}
+
+template<class T>
+void PrepService<T>::serve(BufferPrep<T>& prep, Player& P,
+        function<void()> check, const key_type& key, int worker)
+{
+    Queue* queue;
+    {
+        lock_guard<mutex> l(lock);
+        queue = &queues.at(key);
+    }
+
+    for (long seq = worker;; seq += n_workers)
+    {
+        {
+            unique_lock<mutex> l(lock);
+            cond.wait(l, [&]()
+            {
+                return stopping or seq < queue->consumed + depth
+                        or not error.empty();
+            });
+            // finish batches that the other parties generate as well
+            if (seq >= queue->consumed + depth or not error.empty())
+                break;
+        }
+
+        Batch batch;
+        switch (key[0])
+        {
+        case TRIPLES:
+            prep.buffer_triples();
+            swap(batch.triples, prep.triples);
+            assert(not batch.triples.empty());
+            break;
+        case BITS:
+            prep.buffer_bits();
+            swap(batch.bits, prep.bits);
+            assert(not batch.bits.empty());
+            break;
+        case DABITS:
+            prep.buffer_dabits(0);
+            swap(batch.dabits, prep.dabits);
+            assert(not batch.dabits.empty());
+            break;
+        case EDABITS:
+            prep.buffer_edabits(key[1], key[2], 0);
+            swap(batch.edabits, prep.edabits[{bool(key[1]), key[2]}]);
+            assert(not batch.edabits.empty());
+            break;
+        }
+        // has to happen before using anything online
+        check();
+
+        lock_guard<mutex> l(lock);
+        queue->ready[seq] = std::move(batch);
+        cond.notify_all();
+    }
+
+    lock_guard<mutex> l(lock);
+    comm += P.total_comm();
+}
+
+template<class T>
+void PrepService<T>::stop()
+{
+    {
+        lock_guard<mutex> l(lock);
+        stopping = true;
+    }
+    cond.notify_all();
+    for (auto& queue : queues)
+        for (auto& worker : queue.second.workers)
+            if (worker.joinable())
+                worker.join();
+}
+
+template<class T>
+void PrepService<T>::print_stats()
+{
+    if (stats.empty())
+        return;
+
+    cerr << "Shared preprocessing batches (ready/waited for):" << endl;
+    for (auto& thread_stats : stats)
+    {
+        cerr << "\tThread " << thread_stats.first << ": ";
+        bool first = true;
+        for (auto& x : thread_stats.second)
+        {
+            if (not first)
+                cerr << ", ";
+            first = false;
+            cerr << x.second[0] << "/" << x.second[1] << " " << name(x.first);
+        }
+        cerr << endl;
+    }
+}
+
+#endif /* PROTOCOLS_PREPSERVICE_HPP_ */
@@ -7,6 +7,7 @@
 #define PROTOCOLS_REP3SHUFFLER_HPP_
 
 #include "Rep3Shuffler.h"
+#include "Tools/ScratchVector.h"
 
 template<class T>
 Rep3Shuffler<T>::Rep3Shuffler(StackedVector<T>& a, size_t n, int unit_size,
@@ -59,13 +60,13 @@ void Rep3Shuffler<T>::apply(StackedVector<T>& a, size_t n, int unit_size,
 
     stats[n / unit_size] += unit_size;
 
-    vector<T> to_shuffle;
+    ScratchVector<T> to_shuffle;
     for (size_t i = 0; i < n; i++)
         to_shuffle.push_back(a[input_base + i]);
 
     typename T::Input input(proc);
 
-    vector<typename T::clear> to_share(n);
+    ScratchVector<typename T::clear> to_share(n);
 
     for (int ii = 0; ii < 3; ii++)
     {
@@ -91,7 +91,9 @@ public:
     T finalize_dotprod(int length);
 
     T get_random();
+    void get_random_many(T* res, size_t n);
     void randoms(T& res, int n_bits);
+    void randoms(T* res, size_t n, int n_bits);
 
     void trunc_pr(const vector<int>& regs, int size, SubProcessor<T>& proc);
 
@@ -325,6 +325,12 @@ T Rep4<T>::get_random()
     return res;
 }
 
+template<class T>
+void Rep4<T>::get_random_many(T* res, size_t n)
+{
+    ReplicatedBase::randomize_many(res, n, rep_prngs);
+}
+
 template<class T>
 void Rep4<T>::randoms(T& res, int n_bits)
 {
@@ -332,6 +338,17 @@ void Rep4<T>::randoms(T& res, int n_bits)
         res[i].randomize_part(rep_prngs[i], n_bits);
 }
 
+template<class T>
+void Rep4<T>::randoms(T* res, size_t n, int n_bits)
+{
+    if (not T::clear::prime_field and not T::clear::characteristic_two
+            and n_bits >= T::clear::length())
+        get_random_many(res, n);
+    else
+        for (size_t i = 0; i < n; i++)
+            randoms(res[i], n_bits);
+}
+
 template<class T>
 void Rep4<T>::trunc_pr(const vector<int>& regs, int size,
         SubProcessor<T>& proc)
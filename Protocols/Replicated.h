@@ -41,6 +41,20 @@ public:
     ReplicatedBase branch() const;
 
     int get_n_relevant_players() { return P.num_players() - 1; }
+
+    // fill shares by running through one PRNG after the other
+    template<class T, class U>
+    static void randomize_many(T* res, size_t n, U& prngs)
+    {
+        typedef typename T::value_type value_type;
+        vector<value_type> tmp(n);
+        for (size_t i = 0; i < prngs.size(); i++)
+        {
+            value_type::randomize_many(tmp.data(), n, prngs[i]);
+            for (size_t j = 0; j < n; j++)
+                res[j][i] = tmp[j];
+        }
+    }
 };
 
 /**
@@ -105,11 +119,13 @@ public:
     T finalize_dotprod(int length);
 
     virtual T get_random();
+    virtual void get_random_many(T* res, size_t n);
 
     virtual void trunc_pr(const vector<int>& regs, int size, SubProcessor<T>& proc)
     { (void) regs, (void) size; (void) proc; throw runtime_error("trunc_pr not implemented"); }
 
     virtual void randoms(T&, int) { throw runtime_error("randoms not implemented"); }
+    virtual void randoms(T* res, size_t n, int n_bits);
     virtual void randoms_inst(StackedVector<T>&, const Instruction&);
 
     template<int = 0>
@@ -181,7 +197,9 @@ public:
     void trunc_pr(const vector<int>& regs, int size, U& proc);
 
     T get_random();
+    void get_random_many(T* res, size_t n);
     void randoms(T& res, int n_bits);
+    void randoms(T* res, size_t n, int n_bits);
 
     void start_exchange();
     void stop_exchange();
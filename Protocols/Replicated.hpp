@@ -152,6 +152,13 @@ T ProtocolBase<T>::get_random()
     return res;
 }
 
+template<class T>
+void ProtocolBase<T>::get_random_many(T* res, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        res[i] = get_random();
+}
+
 template<class T>
 vector<int> ProtocolBase<T>::get_relevant_players()
 {
@@ -269,15 +276,26 @@ T Replicated<T>::get_random()
     return res;
 }
 
+template<class T>
+void Replicated<T>::get_random_many(T* res, size_t n)
+{
+    ReplicatedBase::randomize_many(res, n, shared_prngs);
+}
+
 template<class T>
 void ProtocolBase<T>::randoms_inst(StackedVector<T>& S,
 		const Instruction& instruction)
 {
-    for (int j = 0; j < instruction.get_size(); j++)
-    {
-        auto& res = S[instruction.get_r(0) + j];
-        randoms(res, instruction.get_n());
-    }
+    if (instruction.get_size() > 0)
+        randoms(&S[instruction.get_r(0)], instruction.get_size(),
+                instruction.get_n());
+}
+
+template<class T>
+void ProtocolBase<T>::randoms(T* res, size_t n, int n_bits)
+{
+    for (size_t i = 0; i < n; i++)
+        randoms(res[i], n_bits);
 }
 
 template<class T>
@@ -287,6 +305,17 @@ void Replicated<T>::randoms(T& res, int n_bits)
         res[i].randomize_part(shared_prngs[i], n_bits);
 }
 
+template<class T>
+void Replicated<T>::randoms(T* res, size_t n, int n_bits)
+{
+    if (not T::clear::prime_field and not T::clear::characteristic_two
+            and n_bits >= T::clear::length())
+        get_random_many(res, n);
+    else
+        for (size_t i = 0; i < n; i++)
+            randoms(res[i], n_bits);
+}
+
 template<class T>
 template<class U>
 void Replicated<T>::trunc_pr(const vector<int>& regs, int size, U& proc,
@@ -16,6 +16,8 @@
 #include "Tools/TimerWithComm.h"
 #include "edabit.h"
 #include "DabitSacrifice.h"
+#include "EdabitFactory.h"
+#include "PrepService.h"
 
 #include <array>
 
@@ -36,6 +38,8 @@ class BufferPrep : public Preprocessing<T>
     template<class U, class V> friend class Machine;
 
     friend class InScope;
+    friend class EdabitFactory<T>;
+    friend class PrepService<T>;
 
     static const bool homomorphic = false;
 
@@ -90,6 +94,11 @@ protected:
 public:
     typedef T share_type;
 
+    /// Background generation of daBits and edaBits if not null
+    EdabitFactory<T>* edabit_factory;
+    /// Preprocessing shared between threads if not null
+    PrepService<T>* prep_service;
+
     /// Key-independent setup if necessary (cryptosystem parameters)
     static void basic_setup(Player& P) { (void) P; }
     /// Generate keys if necessary
@@ -11,6 +11,8 @@
 #include "BufferScope.h"
 #include "SemiRep3Prep.h"
 #include "DabitSacrifice.h"
+#include "EdabitFactory.hpp"
+#include "PrepService.hpp"
 #include "Spdz2kPrep.h"
 #include "GC/BitAdder.h"
 #include "Processor/OnlineOptions.h"
@@ -62,7 +64,8 @@ public:
 template<class T>
 BufferPrep<T>::BufferPrep(DataPositions& usage) :
         Preprocessing<T>(usage), n_bit_rounds(0),
-		proc(0), P(0)
+		proc(0), P(0), edabit_factory(0),
+		prep_service(0)
 {
 }
 
@@ -200,11 +203,13 @@ void generate_triples_initialized(vector<array<T, 3>>& triples, int n_triples,
 {
     triples.resize(n_triples);
     BufferScope scope(*protocol, 2 * triples.size());
+    vector<T> randoms(2 * triples.size());
+    protocol->get_random_many(randoms.data(), randoms.size());
     for (size_t i = 0; i < triples.size(); i++)
     {
         auto& triple = triples[i];
-        triple[0] = protocol->get_random();
-        triple[1] = protocol->get_random();
+        triple[0] = randoms[2 * i];
+        triple[1] = randoms[2 * i + 1];
         protocol->prepare_mul(triple[0], triple[1], n_bits);
     }
     protocol->exchange();
@@ -223,7 +228,10 @@ void BufferPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
         if (OnlineOptions::singleton.has_option("verbose_triples"))
             fprintf(stderr, "out of %s triples\n", T::type_string().c_str());
         InScope in_scope(this->do_count, false, *this);
-        buffer_triples();
+        if (prep_service and proc)
+            prep_service->take(triples, proc->P);
+        else
+            buffer_triples();
         assert(not triples.empty());
     }
 
@@ -268,10 +276,12 @@ void generate_squares(vector<array<T, 2>>& squares, int n_squares,
     assert(protocol != 0);
     squares.resize(n_squares);
     protocol->init_mul();
+    vector<T> randoms(squares.size());
+    protocol->get_random_many(randoms.data(), randoms.size());
     for (size_t i = 0; i < squares.size(); i++)
     {
         auto& square = squares[i];
-        square[0] = protocol->get_random();
+        square[0] = randoms[i];
         protocol->prepare_mul(square[0], square[0]);
     }
     protocol->exchange();
@@ -742,11 +752,11 @@ void SemiRep3Prep<T>::buffer_dabits(ThreadQueues*)
     vector<array<T, 3>> a(n_bits);
     Player& P = this->proc->P;
 
+    ReplicatedBase::randomize_many(b.data(), b.size(),
+            this->protocol->shared_prngs);
+
     for (int i = 0; i < 2; i++)
     {
-        for (auto& x : b)
-            x[i].randomize(this->protocol->shared_prngs[i]);
-
         int j = P.get_offset(i);
 
         for (int k = 0; k < n_bits; k++)
@@ -1155,7 +1165,10 @@ void BufferPrep<T>::get_one_no_count(Dtype dtype, T& a)
     while (bits.empty())
     {
         InScope in_scope(this->do_count, false, *this);
-        buffer_bits();
+        if (prep_service and proc)
+            prep_service->take(bits, proc->P);
+        else
+            buffer_bits();
         n_bit_rounds++;
     }
 
@@ -1186,8 +1199,15 @@ void BufferPrep<T>::get_dabit_no_count(T& a, typename T::bit_type& b)
     if (dabits.empty())
     {
         InScope in_scope(this->do_count, false, *this);
-        ThreadQueues* queues = 0;
-        buffer_dabits(queues);
+        if (edabit_factory and edabit_factory->serves({false, 0}))
+            edabit_factory->take(dabits, this->usage);
+        else if (prep_service and proc)
+            prep_service->take(dabits, proc->P);
+        else
+        {
+            ThreadQueues* queues = 0;
+            buffer_dabits(queues);
+        }
         assert(not dabits.empty());
     }
     a = dabits.back().first;
@@ -1223,7 +1243,12 @@ edabitvec<T> BufferPrep<T>::get_edabitvec(bool strict, int n_bits)
     if (buffer.empty())
     {
         InScope in_scope(this->do_count, false, *this);
-        buffer_edabits_with_queues(strict, n_bits);
+        if (edabit_factory and edabit_factory->serves({strict, n_bits}))
+            edabit_factory->take(buffer, strict, n_bits, this->usage);
+        else if (prep_service and proc)
+            prep_service->take(buffer, strict, n_bits, proc->P);
+        else
+            buffer_edabits_with_queues(strict, n_bits);
     }
     assert(not buffer.empty());
     auto res = buffer.back();
@@ -1259,7 +1284,7 @@ template<class T>
 void BufferPrep<T>::buffer_edabits_with_queues(bool strict, int n_bits)
 {
     ThreadQueues* queues = 0;
-    if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton())
+    if (BaseMachine::is_main_thread() and BaseMachine::has_singleton())
         queues = &BaseMachine::s().queues;
     buffer_edabits(strict, n_bits, queues);
 }
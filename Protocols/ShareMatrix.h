@@ -45,6 +45,14 @@ public:
         v.resize(size_);
     }
 
+    // empty with new size, keeping the storage
+    void reserve(size_t size)
+    {
+        size_ = size;
+        v.clear();
+        v.reserve(size);
+    }
+
     void check() const
     {
 #ifdef DEBUG_MATRIX
@@ -164,6 +172,13 @@ public:
         assert(entries.size() == size_t(n_rows * n_cols));
     }
 
+    void reset(int n_rows, int n_cols)
+    {
+        this->n_rows = n_rows;
+        this->n_cols = n_cols;
+        entries.reserve(n_rows * n_cols);
+    }
+
     T& operator[](const pair<int, int>& indices)
     {
 #ifdef DEBUG_MATRIX
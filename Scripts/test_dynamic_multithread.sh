@@ -0,0 +1,18 @@
+#!/usr/bin/env bash
+
+# threads take over chunks with a semi-honest protocol, and the
+# parties compare the schedules with a malicious one
+
+make -j4 semi2k-party.x malicious-rep-ring-party.x || exit 1
+
+./compile.py -R 64 test_dynamic_multithread || exit 1
+
+export PORT=$((RANDOM%10000+10000))
+
+for protocol in semi2k mal-rep-ring; do
+    if ! Scripts/$protocol.sh test_dynamic_multithread > /dev/null ||
+	    ! grep 'dynamic multithread ok' logs/test_dynamic_multithread-0; then
+	cat logs/test_dynamic_multithread-?
+	exit 1
+    fi
+done
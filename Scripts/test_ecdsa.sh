@@ -6,6 +6,8 @@ touch ECDSA/Fake-ECDSA.cpp
 
 make -j4 ecdsa Fake-ECDSA.x
 
+./test-secp256k1.x || exit 1
+
 port=${PORT:-$((RANDOM%10000+10000))}
 
 run()
@@ -21,12 +23,29 @@ run()
     fi
 }
 
+service()
+{
+    echo $1 service
+    if ! {
+	    for j in $(seq 0 $2); do
+		./$1-ecdsa-party.x -pn $port -p $j --load-test 1000 \
+		    --load-requests 200 2>logs/ecdsa-service-$j & true
+	    done
+	    wait
+	} | tee logs/ecdsa-service | grep "signatures per second"; then
+	exit 1
+    fi
+}
+
 for i in rep mal-rep shamir mal-shamir atlas sy-rep; do
     run $i 2
 done
 
 run rep4 3
 
+service rep 2
+service semi 1
+
 for i in semi mascot; do
     run $i 1
 done
@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+
+# secret memory has to survive consecutive runs with '-m mapped'
+
+make -j4 replicated-ring-party.x || exit 1
+
+./compile.py -R 64 test_mapped_memory write || exit 1
+./compile.py -R 64 test_mapped_memory read || exit 1
+
+rm -f Player-Data/Memory-R*
+
+export PORT=$((RANDOM%10000+10000))
+
+Scripts/ring.sh test_mapped_memory-write -m mapped > /dev/null || exit 1
+
+for i in 1 2; do
+    if ! Scripts/ring.sh test_mapped_memory-read -m mapped > /dev/null ||
+	    ! grep 'mapped memory 2998 4997' logs/test_mapped_memory-read-0; then
+	cat logs/test_mapped_memory-read-?
+	exit 1
+    fi
+done
@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+
+# the second run uses the decoded tape stored by the first run
+
+make -j4 replicated-field-party.x || exit 1
+
+./compile.py test_tape_cache || exit 1
+
+rm -f Programs/Bytecode/test_tape_cache-*.pbc
+
+export PORT=$((RANDOM%10000+10000))
+
+for i in 1 2; do
+    if ! Scripts/rep-field.sh test_tape_cache > /dev/null ||
+	    ! grep 'tape cache' logs/test_tape_cache-0 > /tmp/test_tape_cache-$i; then
+	cat logs/test_tape_cache-?
+	exit 1
+    fi
+    if ! test -e Programs/Bytecode/test_tape_cache-0.pbc; then
+	echo no tape cache
+	exit 1
+    fi
+done
+
+cmp /tmp/test_tape_cache-1 /tmp/test_tape_cache-2 || exit 1
+
+# the prime length requirement still applies with the stored tape
+if Scripts/rep-field.sh test_tape_cache -lgp 64 > /dev/null ||
+	! grep -q 'Tape requires prime of bit length' logs/test_tape_cache-0; then
+    cat logs/test_tape_cache-?
+    exit 1
+fi
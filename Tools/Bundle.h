@@ -39,6 +39,13 @@ public:
                 throw mismatch_among_parties();
     }
 
+    /// Compare hashes instead of full content to save communication
+    void compare_hash(PlayerBase& P)
+    {
+        mine = mine.hash();
+        compare(P);
+    }
+
     void reset()
     {
         for (auto& x : *this)
@@ -71,6 +71,8 @@ public:
 
     void reserve(size_t new_size) { full.reserve(start + new_size); }
 
+    size_t capacity_bytes() const { return full.capacity() * sizeof(T); }
+
     auto begin() { return full.begin() + start; }
     auto end() { return full.end(); }
     auto begin() const { return full.begin() + start; }
@@ -6,7 +6,14 @@
 #include "DiskVector.h"
 #include "Processor/OnlineOptions.h"
 
-#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <string.h>
+#include <errno.h>
 
 void sigbus_handler(int)
 {
@@ -16,29 +23,101 @@ void sigbus_handler(int)
     exit(1);
 }
 
-void DiskVectorBase::init(size_t byte_size)
+DiskVectorBase::DiskVectorBase() :
+        fd(-1), file_size(0), mapping(0), byte_size(0)
 {
-    if (file.is_open())
-        throw runtime_error("resizing of disk memory not implemented");
-    else
+}
+
+DiskVectorBase::~DiskVectorBase()
+{
+    if (mapping)
+        munmap(mapping, file_size);
+    if (fd >= 0)
+        close(fd);
+}
+
+void DiskVectorBase::resize_bytes(size_t new_byte_size)
+{
+    if (fd < 0)
     {
-        path = boost::filesystem::unique_path(
-                (boost::filesystem::path(OnlineOptions::singleton.disk_memory)
-                        / std::string("%%%%-%%%%-%%%%-%%%%")).native());
+        string path = OnlineOptions::singleton.disk_memory + "/XXXXXX";
+        fd = mkstemp(&path[0]);
+        if (fd < 0)
+            throw runtime_error(
+                    "cannot create disk memory in "
+                            + OnlineOptions::singleton.disk_memory + ": "
+                            + strerror(errno));
+        // removed when closed
+        unlink(path.c_str());
+        signal(SIGBUS, sigbus_handler);
+    }
+
+    if (new_byte_size > file_size)
+    {
+        size_t new_file_size = (new_byte_size + CHUNK_SIZE - 1) / CHUNK_SIZE
+                * CHUNK_SIZE;
+        check_space(new_file_size);
+
+        // sparse extension
+        if (ftruncate(fd, new_file_size))
+            throw runtime_error(
+                    "cannot extend disk memory to "
+                            + to_string(new_file_size) + " bytes: "
+                            + strerror(errno));
 
-        std::ofstream f(path.native());
-        f.close();
+        if (mapping)
+            munmap(mapping, file_size);
+        void* res = mmap(0, new_file_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                fd, 0);
+        if (res == MAP_FAILED)
+            throw runtime_error(
+                    string("cannot map disk memory: ") + strerror(errno));
+
+        mapping = (char*) res;
+        file_size = new_file_size;
     }
+    else if (new_byte_size < byte_size)
+        // later growth has to see zeros
+        memset(mapping + new_byte_size, 0, byte_size - new_byte_size);
+
+    byte_size = new_byte_size;
+}
+
+void DiskVectorBase::check_space(size_t new_file_size)
+{
+    struct stat st;
+    struct statvfs vfs;
+    if (fstat(fd, &st) or fstatvfs(fd, &vfs))
+        return;
 
-    if (truncate(path.native().c_str(), byte_size))
-        throw std::runtime_error(
-                "cannot allocate " + std::to_string(byte_size) + " bytes in "
-                        + path.native() + ": " + strerror(errno));
+    size_t used = st.st_blocks * 512;
+    size_t available = vfs.f_bavail * vfs.f_frsize;
+    if (new_file_size > used + available)
+        cerr << "Warning: disk memory of " << new_file_size * 1e-9
+                << " GB exceeds the " << (used + available) * 1e-9
+                << " GB available on " << OnlineOptions::singleton.disk_memory
+                << ", which only works if it stays sparse" << endl;
+}
 
-    file.open(path, boost::iostreams::mapped_file::readwrite, byte_size);
-    assert(file.size() == byte_size);
+void DiskVectorBase::prefetch_bytes(size_t begin, size_t end)
+{
+    end = min(end, byte_size);
+    if (not mapping or begin >= end)
+        return;
 
-    boost::filesystem::remove(path);
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    begin = begin / page_size * page_size;
+    madvise(mapping + begin, end - begin, MADV_WILLNEED);
+}
+
+void DiskVectorBase::write_behind()
+{
+    if (fd < 0)
+        return;
 
-    signal(SIGBUS, sigbus_handler);
+#ifdef SYNC_FILE_RANGE_WRITE
+    sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE);
+#else
+    msync(mapping, file_size, MS_ASYNC);
+#endif
 }
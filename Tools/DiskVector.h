@@ -6,78 +6,87 @@
 #ifndef TOOLS_DISKVECTOR_H_
 #define TOOLS_DISKVECTOR_H_
 
-#include <boost/iostreams/device/mapped_file.hpp>
-#include <boost/filesystem.hpp>
+#include <stddef.h>
+#include <assert.h>
 
+/**
+ * Memory in a sparse temporary file on disk.
+ * The file grows in chunks and only occupies disk space where written.
+ */
 class DiskVectorBase
 {
+    static const size_t CHUNK_SIZE = 1 << 26;
+
+    int fd;
+    size_t file_size;
+
+    void check_space(size_t new_file_size);
+
 protected:
-    boost::iostreams::mapped_file file;
-    boost::filesystem::path path;
+    char* mapping;
+    size_t byte_size;
+
+    void resize_bytes(size_t new_byte_size);
 
 public:
-    ~DiskVectorBase()
-    {
-        boost::filesystem::remove(path);
-    }
+    DiskVectorBase();
+    ~DiskVectorBase();
 
-    void init(size_t byte_size);
+    // asynchronous read-ahead of a byte range
+    void prefetch_bytes(size_t begin, size_t end);
+    // start writing back modified pages without waiting
+    void write_behind();
 };
 
 template<class T>
-class DiskVector : DiskVectorBase
+class DiskVector : public DiskVectorBase
 {
-    size_t size_;
-    T* data_;
-
 public:
-    DiskVector() : size_(0), data_(0)
+    size_t size() const
     {
+        return byte_size / sizeof(T);
     }
 
-    size_t size() const
+    void resize(size_t new_size)
     {
-        return size_;
+        resize_bytes(new_size * sizeof(T));
     }
 
-    void resize(size_t new_size)
+    void prefetch(size_t begin, size_t end)
     {
-        auto byte_size = new_size * sizeof(T);
-        init(byte_size);
-        size_ = new_size;
-        data_ = (T*) file.data();
+        prefetch_bytes(begin * sizeof(T), end * sizeof(T));
     }
 
     T* data()
     {
-        return data_;
+        return (T*) mapping;
     }
 
     const T* data() const
     {
-        return data_;
+        return (T*) mapping;
     }
 
     T& operator[](size_t index)
     {
-        return data_[index];
+        return data()[index];
     }
 
     const T& operator[](size_t index) const
     {
-        return data_[index];
+        return data()[index];
     }
 
     T& at(size_t index)
     {
-        assert(index <= size_);
-        return data_[index];
+        assert(index < size());
+        return data()[index];
     }
 
     const T& at(size_t index) const
     {
-        assert(index <= size_);
-        return data_[index];
+        assert(index < size());
+        return data()[index];
     }
 };
 
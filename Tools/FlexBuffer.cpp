@@ -13,6 +13,38 @@ using namespace std;
 #define BUFFER_DIR "/tmp"
 #endif
 
+// keeps unread part followed by unread part of other,
+// growing geometrically and compacting only if the head is past half
+void ReceivedMsg::append(ReceivedMsg& other)
+{
+	if (left() == 0)
+	{
+		*this = other;
+		return;
+	}
+
+	size_t n_left = left(), n_other = other.left();
+	size_t n_total = n_left + n_other;
+	if (len + n_other > max_len)
+	{
+		if (n_total <= max_len and size_t(ptr - buf) >= max_len / 2)
+			memmove(buf, ptr, n_left);
+		else
+		{
+			max_len = 2 * n_total;
+			char* new_buf = new char[max_len];
+			avx_memcpy(new_buf, ptr, n_left);
+			delete[] buf;
+			buf = new_buf;
+		}
+		ptr = buf;
+		len = n_left;
+	}
+	avx_memcpy(buf + len, other.ptr, n_other);
+	len += n_other;
+	other.del();
+}
+
 ReceivedMsgStore::~ReceivedMsgStore()
 {
 #ifdef VERBOSE
@@ -53,6 +53,7 @@ public:
 	char pop_front() { check_buffer(1); return *ptr++; }
 	size_t left() { return len - (ptr - buf); }
 	void check_buffer(size_t size);
+	void append(ReceivedMsg& other);
 };
 
 class SendBuffer : public virtual FlexBuffer
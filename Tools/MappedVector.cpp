@@ -0,0 +1,96 @@
+/*
+ * MappedVector.cpp
+ *
+ */
+
+#include "MappedVector.h"
+#include "Exceptions.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+MappedVectorBase::MappedVectorBase() :
+        fd(-1), mapping(0), byte_size(0)
+{
+}
+
+MappedVectorBase::~MappedVectorBase()
+{
+    if (mapping)
+    {
+        msync(mapping, HEADER_SIZE + byte_size, MS_SYNC);
+        munmap(mapping, HEADER_SIZE + byte_size);
+    }
+    if (fd >= 0)
+        close(fd);
+}
+
+void MappedVectorBase::open(const string& filename, const string& type,
+        size_t element_size)
+{
+    assert(fd < 0);
+    this->filename = filename;
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0)
+        throw file_error(filename + ": " + strerror(errno));
+
+    string header = "MP-SPDZ memory\n" + type + "\n"
+            + to_string(element_size) + "\n";
+    assert(header.size() < HEADER_SIZE);
+
+    struct stat st;
+    if (fstat(fd, &st))
+        throw file_error(filename + ": " + strerror(errno));
+    size_t file_size = st.st_size;
+
+    if (file_size == 0)
+    {
+        char buffer[HEADER_SIZE] = {};
+        memcpy(buffer, header.c_str(), header.size());
+        if (write(fd, buffer, HEADER_SIZE) != (ssize_t) HEADER_SIZE)
+            throw file_error(filename + ": " + strerror(errno));
+        file_size = HEADER_SIZE;
+    }
+
+    if (file_size < HEADER_SIZE or (file_size - HEADER_SIZE) % element_size)
+        throw runtime_error("invalid memory file " + filename);
+
+    remap(file_size - HEADER_SIZE);
+
+    if (memcmp(mapping, header.c_str(), header.size()))
+        throw runtime_error(
+                "memory file " + filename + " is not for " + type
+                        + ". Run with '-m empty' or delete it.");
+}
+
+void MappedVectorBase::remap(size_t new_byte_size)
+{
+    if (fd < 0)
+        throw runtime_error("mapped memory not opened");
+
+    if (mapping)
+    {
+        if (new_byte_size == byte_size)
+            return;
+        munmap(mapping, HEADER_SIZE + byte_size);
+        mapping = 0;
+    }
+
+    size_t total = HEADER_SIZE + new_byte_size;
+    if (ftruncate(fd, total))
+        throw runtime_error(
+                "cannot extend " + filename + " to " + to_string(total)
+                        + " bytes: " + strerror(errno));
+
+    void* res = mmap(0, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (res == MAP_FAILED)
+        throw runtime_error(
+                "cannot map " + filename + ": " + strerror(errno));
+
+    mapping = (char*) res;
+    byte_size = new_byte_size;
+}
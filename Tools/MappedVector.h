@@ -0,0 +1,103 @@
+/*
+ * MappedVector.h
+ *
+ */
+
+#ifndef TOOLS_MAPPEDVECTOR_H_
+#define TOOLS_MAPPEDVECTOR_H_
+
+#include <string>
+#include <assert.h>
+using namespace std;
+
+/**
+ * Persistent memory in a file mapped into the address space.
+ * The kernel only writes back modified pages,
+ * and loading does not read anything until accessed.
+ */
+class MappedVectorBase
+{
+protected:
+    static const size_t HEADER_SIZE = 4096;
+
+    int fd;
+    char* mapping;
+    size_t byte_size;
+    string filename;
+
+    void open(const string& filename, const string& type, size_t element_size);
+    void remap(size_t new_byte_size);
+
+public:
+    MappedVectorBase();
+    ~MappedVectorBase();
+};
+
+template<class T>
+class MappedVector : MappedVectorBase
+{
+    size_t size_;
+    T* data_;
+
+    void update()
+    {
+        size_ = byte_size / sizeof(T);
+        data_ = (T*) (mapping + HEADER_SIZE);
+    }
+
+public:
+    MappedVector() : size_(0), data_(0)
+    {
+    }
+
+    void open(const string& filename)
+    {
+        MappedVectorBase::open(filename, T::type_string(), sizeof(T));
+        update();
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    void resize(size_t new_size)
+    {
+        remap(new_size * sizeof(T));
+        update();
+    }
+
+    T* data()
+    {
+        return data_;
+    }
+
+    const T* data() const
+    {
+        return data_;
+    }
+
+    T& operator[](size_t index)
+    {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data_[index];
+    }
+
+    T& at(size_t index)
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+};
+
+#endif /* TOOLS_MAPPEDVECTOR_H_ */
@@ -0,0 +1,144 @@
+/*
+ * MemoryPolicy.cpp
+ *
+ */
+
+#include "MemoryPolicy.h"
+#include "Processor/OnlineOptions.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+#ifndef MPOL_LOCAL
+#define MPOL_LOCAL 4
+#endif
+
+MemoryPolicy MemoryPolicy::singleton;
+
+MemoryPolicy::MemoryPolicy() :
+        initialized(false), active(false), thp(false), huge(false),
+        interleave(false), local(false), pin(false)
+{
+}
+
+MemoryPolicy& MemoryPolicy::get()
+{
+    static mutex lock;
+    lock_guard<mutex> _(lock);
+    if (not singleton.initialized)
+        singleton.init();
+    return singleton;
+}
+
+void MemoryPolicy::init()
+{
+    parse(OnlineOptions::singleton.memory_policy);
+
+    string list;
+    ifstream file("/sys/devices/system/node/online");
+    getline(file, list);
+    nodes = parse_list(list);
+
+    for (int node : nodes)
+    {
+        string cpus;
+        ifstream cpu_file(
+                "/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+        getline(cpu_file, cpus);
+        node_cpus.push_back(parse_list(cpus));
+    }
+
+    initialized = true;
+}
+
+void MemoryPolicy::parse(const string& policy)
+{
+    stringstream ss(policy);
+    string item;
+    while (getline(ss, item, ','))
+    {
+        if (item == "thp")
+            thp = true;
+        else if (item == "huge")
+            huge = true;
+        else if (item == "interleave")
+            interleave = true;
+        else if (item == "local")
+            local = true;
+        else if (item == "pin")
+            pin = true;
+        else
+            throw runtime_error("unknown memory policy: " + item);
+        active = true;
+    }
+
+    if (interleave and local)
+        throw runtime_error("memory cannot be interleaved and local");
+}
+
+vector<int> MemoryPolicy::parse_list(const string& list)
+{
+    vector<int> res;
+    stringstream ss(list);
+    string item;
+    while (getline(ss, item, ','))
+    {
+        if (item.empty())
+            continue;
+        auto dash = item.find('-');
+        int first = stoi(item.substr(0, dash));
+        int last = dash == string::npos ? first : stoi(item.substr(dash + 1));
+        for (int i = first; i <= last; i++)
+            res.push_back(i);
+    }
+    return res;
+}
+
+void MemoryPolicy::apply(void* start, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    if (thp or huge)
+        madvise(start, size, MADV_HUGEPAGE);
+#endif
+
+#ifdef SYS_mbind
+    if (interleave and nodes.size() > 1)
+    {
+        vector<unsigned long> mask(nodes.back() / 64 + 1);
+        for (int node : nodes)
+            mask[node / 64] |= 1ul << (node % 64);
+        if (syscall(SYS_mbind, start, size, MPOL_INTERLEAVE, mask.data(),
+                64 * mask.size(), 0))
+            cerr << "Cannot interleave memory: " << strerror(errno) << endl;
+    }
+
+    if (local)
+        if (syscall(SYS_mbind, start, size, MPOL_LOCAL, 0, 0, 0))
+            cerr << "Cannot bind memory locally: " << strerror(errno) << endl;
+#else
+    (void) start, (void) size;
+#endif
+}
+
+void MemoryPolicy::pin_thread(int thread_num)
+{
+    if (not pin or node_cpus.empty() or thread_num < 0)
+        return;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int cpu : node_cpus[thread_num % node_cpus.size()])
+        CPU_SET(cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus))
+        cerr << "Cannot pin thread " << thread_num << endl;
+}
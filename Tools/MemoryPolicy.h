@@ -0,0 +1,54 @@
+/*
+ * MemoryPolicy.h
+ *
+ */
+
+#ifndef TOOLS_MEMORYPOLICY_H_
+#define TOOLS_MEMORYPOLICY_H_
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Page size and NUMA placement of secret memory
+ * as well as matching thread placement (``--memory-policy``).
+ * Comma-separated list of:
+ * ``thp`` (transparent huge pages),
+ * ``huge`` (explicit huge pages, falling back to ``thp``),
+ * ``interleave`` (pages round-robin on all NUMA nodes),
+ * ``local`` (pages on the node of the first thread writing to them
+ * even if the process has a different default policy),
+ * ``pin`` (threads round-robin on NUMA nodes).
+ */
+class MemoryPolicy
+{
+    static MemoryPolicy singleton;
+
+    bool initialized;
+    vector<int> nodes;
+    vector<vector<int>> node_cpus;
+
+    void init();
+
+public:
+    bool active;
+    bool thp, huge, interleave, local, pin;
+
+    static MemoryPolicy& get();
+
+    // list format of sysfs such as "0-3,8-11"
+    static vector<int> parse_list(const string& list);
+
+    MemoryPolicy();
+
+    void parse(const string& policy);
+
+    // to be called before touching the pages
+    void apply(void* start, size_t size);
+
+    // binds the calling thread to the CPUs of a NUMA node
+    void pin_thread(int thread_num);
+};
+
+#endif /* TOOLS_MEMORYPOLICY_H_ */
@@ -7,6 +7,8 @@
 #define TOOLS_MEMORYUSAGE_H_
 
 #include <map>
+#include <string>
+#include <iostream>
 using namespace std;
 
 class MemoryUsage
@@ -36,10 +38,10 @@ public:
         return usage[tag];
     }
 
-    void print()
+    void print(ostream& os = cout)
     {
         for (auto& it : usage)
-            cout << it.first << " required: " << 1e-9 * it.second << " (GB)" << endl;
+            os << it.first << " required: " << 1e-9 * it.second << " (GB)" << endl;
     }
 };
 
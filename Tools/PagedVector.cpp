@@ -0,0 +1,96 @@
+/*
+ * PagedVector.cpp
+ *
+ */
+
+#include "PagedVector.h"
+#include "MemoryPolicy.h"
+
+#include <sys/mman.h>
+#include <string.h>
+#include <errno.h>
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+PagedVectorBase::PagedVectorBase() :
+        use_huge(MemoryPolicy::get().huge), mapping(0), byte_size(0),
+        mapped_size(0)
+{
+}
+
+PagedVectorBase::~PagedVectorBase()
+{
+    if (mapping)
+        munmap(mapping, mapped_size);
+}
+
+void PagedVectorBase::remap(size_t new_byte_size)
+{
+    if (new_byte_size <= mapped_size)
+    {
+        // keep the mapping but zero memory beyond the new size
+        if (new_byte_size < byte_size)
+            memset(mapping + new_byte_size, 0, byte_size - new_byte_size);
+        byte_size = new_byte_size;
+        return;
+    }
+
+    // whole huge pages to avoid mixed sizes
+    size_t new_mapped_size = (new_byte_size + HUGE_PAGE_SIZE - 1)
+            / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+#ifdef MREMAP_MAYMOVE
+    // moving the pages instead of copying them keeps their placement
+    if (mapping)
+    {
+        void* res = mremap(mapping, mapped_size, new_mapped_size,
+                MREMAP_MAYMOVE);
+        if (res != MAP_FAILED)
+        {
+            MemoryPolicy::get().apply((char*) res + mapped_size,
+                    new_mapped_size - mapped_size);
+            mapping = (char*) res;
+            byte_size = new_byte_size;
+            mapped_size = new_mapped_size;
+            return;
+        }
+    }
+#endif
+
+    void* res = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (use_huge)
+    {
+        res = mmap(0, new_mapped_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (res == MAP_FAILED)
+        {
+            cerr << "Cannot allocate explicit huge pages (" << strerror(errno)
+                    << "), check /proc/sys/vm/nr_hugepages. "
+                    << "Using transparent huge pages instead." << endl;
+            use_huge = false;
+        }
+    }
+#endif
+
+    if (res == MAP_FAILED)
+        res = mmap(0, new_mapped_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (res == MAP_FAILED)
+        throw bad_alloc();
+
+    // placement has to be decided before the pages are touched,
+    // which includes copying the old content
+    MemoryPolicy::get().apply(res, new_mapped_size);
+
+    if (mapping)
+    {
+        memcpy(res, mapping, byte_size);
+        munmap(mapping, mapped_size);
+    }
+
+    mapping = (char*) res;
+    byte_size = new_byte_size;
+    mapped_size = new_mapped_size;
+}
@@ -0,0 +1,81 @@
+/*
+ * PagedVector.h
+ *
+ */
+
+#ifndef TOOLS_PAGEDVECTOR_H_
+#define TOOLS_PAGEDVECTOR_H_
+
+#include <stddef.h>
+#include <assert.h>
+
+/**
+ * Anonymous memory mapping following the memory policy (page size and
+ * NUMA placement). New memory is zero and only placed when first
+ * written to unless interleaved.
+ */
+class PagedVectorBase
+{
+    static const size_t HUGE_PAGE_SIZE = 1 << 21;
+
+    bool use_huge;
+
+protected:
+    char* mapping;
+    size_t byte_size, mapped_size;
+
+    void remap(size_t new_byte_size);
+
+public:
+    PagedVectorBase();
+    ~PagedVectorBase();
+};
+
+template<class T>
+class PagedVector : PagedVectorBase
+{
+public:
+    size_t size() const
+    {
+        return byte_size / sizeof(T);
+    }
+
+    void resize(size_t new_size)
+    {
+        remap(new_size * sizeof(T));
+    }
+
+    T* data()
+    {
+        return (T*) mapping;
+    }
+
+    const T* data() const
+    {
+        return (T*) mapping;
+    }
+
+    T& operator[](size_t index)
+    {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data()[index];
+    }
+
+    T& at(size_t index)
+    {
+        assert(index < size());
+        return data()[index];
+    }
+
+    const T& at(size_t index) const
+    {
+        assert(index < size());
+        return data()[index];
+    }
+};
+
+#endif /* TOOLS_PAGEDVECTOR_H_ */
@@ -0,0 +1,21 @@
+/*
+ * ScratchVector.cpp
+ *
+ */
+
+#include "ScratchVector.h"
+
+mutex ScratchPools::lock;
+MemoryUsage ScratchPools::usage;
+
+void ScratchPools::add(const string& tag, size_t bytes)
+{
+    lock_guard<mutex> _(lock);
+    usage.add(tag, bytes);
+}
+
+void ScratchPools::print(ostream& os)
+{
+    lock_guard<mutex> _(lock);
+    usage.print(os);
+}
@@ -0,0 +1,99 @@
+/*
+ * ScratchVector.h
+ *
+ */
+
+#ifndef TOOLS_SCRATCHVECTOR_H_
+#define TOOLS_SCRATCHVECTOR_H_
+
+#include "MemoryUsage.h"
+
+#include <vector>
+#include <mutex>
+using namespace std;
+
+/**
+ * Memory usage of per-thread buffers, collected when threads finish
+ */
+class ScratchPools
+{
+    static mutex lock;
+    static MemoryUsage usage;
+
+public:
+    static void add(const string& tag, size_t bytes);
+    static void print(ostream& os);
+};
+
+/**
+ * Per-thread pool of vectors that keep their capacity
+ * (high-water mark) when returned
+ */
+template<class T>
+class ScratchPool
+{
+    vector<vector<T>> free;
+    size_t high_water;
+
+    ScratchPool() : high_water(0) {}
+
+public:
+    static ScratchPool& get()
+    {
+        thread_local ScratchPool<T> pool;
+        return pool;
+    }
+
+    ~ScratchPool()
+    {
+        if (high_water)
+            ScratchPools::add("scratch vectors", high_water);
+    }
+
+    vector<T> take()
+    {
+        if (free.empty())
+            return {};
+        auto res = std::move(free.back());
+        free.pop_back();
+        return res;
+    }
+
+    void give(vector<T>& x)
+    {
+        x.clear();
+        size_t bytes = x.capacity() * sizeof(T);
+        for (auto& y : free)
+            bytes += y.capacity() * sizeof(T);
+        high_water = max(high_water, bytes);
+        free.push_back(std::move(x));
+    }
+};
+
+/**
+ * Temporary vector using memory from the thread's pool
+ */
+template<class T>
+class ScratchVector : public vector<T>
+{
+public:
+    ScratchVector() :
+            vector<T>(ScratchPool<T>::get().take())
+    {
+    }
+
+    ScratchVector(size_t size) :
+            ScratchVector()
+    {
+        this->resize(size);
+    }
+
+    ScratchVector(const ScratchVector<T>&) = delete;
+
+    ~ScratchVector()
+    {
+        ScratchPool<T>::get().give(*this);
+    }
+};
+
+#endif /* TOOLS_SCRATCHVECTOR_H_ */
@@ -7,6 +7,7 @@
 #define TOOLS_WAITQUEUE_H_
 
 #include <pthread.h>
+#include <time.h>
 #include <deque>
 using namespace std;
 
@@ -99,6 +100,41 @@ public:
         return something_for_you;
     }
 
+    // returns false if nothing arrives within the timeout
+    bool pop_for(T& value, double seconds)
+    {
+        timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        long ns = deadline.tv_nsec + long(seconds * 1e9);
+        deadline.tv_sec += ns / 1000000000;
+        deadline.tv_nsec = ns % 1000000000;
+        lock();
+        int res = 0;
+        while (running and queue.size() == 0 and res == 0)
+            res = pthread_cond_timedwait(&cond, &mutex, &deadline);
+        bool something_for_you = queue.size() > 0;
+        if (something_for_you)
+        {
+            value = queue.front();
+            queue.pop_front();
+        }
+        unlock();
+        return something_for_you;
+    }
+
+    bool try_pop(T& value)
+    {
+        lock();
+        bool something_for_you = queue.size() > 0;
+        if (something_for_you)
+        {
+            value = queue.front();
+            queue.pop_front();
+        }
+        unlock();
+        return something_for_you;
+    }
+
     void stop()
     {
         lock();
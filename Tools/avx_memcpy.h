@@ -79,4 +79,42 @@ inline void avx_memzero(void* dest, size_t length)
 	}
 }
 
+// dest = x ^ y for non-overlapping or identical ranges
+inline void avx_xor(void* dest, const void* x, const void* y, size_t length)
+{
+	char* d = (char*)dest;
+	const char* a = (const char*)x, *b = (const char*)y;
+#ifdef __AVX512F__
+	while (length >= 64)
+	{
+		_mm512_storeu_si512(d, _mm512_xor_si512(_mm512_loadu_si512(a),
+				_mm512_loadu_si512(b)));
+		d += 64, a += 64, b += 64;
+		length -= 64;
+	}
+#endif
+#ifdef __AVX2__
+	while (length >= 32)
+	{
+		_mm256_storeu_si256((__m256i*)d,
+				_mm256_xor_si256(_mm256_loadu_si256((__m256i*)a),
+						_mm256_loadu_si256((__m256i*)b)));
+		d += 32, a += 32, b += 32;
+		length -= 32;
+	}
+#endif
+#ifdef __SSE2__
+	while (length >= 16)
+	{
+		_mm_storeu_si128((__m128i*)d,
+				_mm_xor_si128(_mm_loadu_si128((__m128i*)a),
+						_mm_loadu_si128((__m128i*)b)));
+		d += 16, a += 16, b += 16;
+		length -= 16;
+	}
+#endif
+	for (size_t i = 0; i < length; i++)
+		d[i] = a[i] ^ b[i];
+}
+
 #endif /* TOOLS_AVX_MEMCPY_H_ */
@@ -116,28 +116,33 @@ void PRNG::print_state() const
 
 
 void PRNG::hash()
+{
+  hash(random);
+  // This is a new random value so we have not used any of it yet
+  cnt=0;
+}
+
+
+void PRNG::hash(octet* output)
 {
   assert(initialized);
   #ifndef USE_AES
     unsigned char tmp[RAND_SIZE + SEED_SIZE];
     randombytes_buf_deterministic(tmp, sizeof tmp, seed);
-    memcpy(random, tmp, RAND_SIZE);
+    memcpy(output, tmp, RAND_SIZE);
     memcpy(seed, tmp + RAND_SIZE, SEED_SIZE);
   #else
     if (useC)
-       { software_ecb_aes_128_encrypt<PIPELINES>((__m128i*)random,(__m128i*)state,KeyScheduleC); }
+       { software_ecb_aes_128_encrypt<PIPELINES>((__m128i*)output,(__m128i*)state,KeyScheduleC); }
     else
-       { ecb_aes_128_encrypt<PIPELINES>((__m128i*)random,(__m128i*)state,KeySchedule); }
+       { ecb_aes_128_encrypt<PIPELINES>((__m128i*)output,(__m128i*)state,KeySchedule); }
   #endif
-  // This is a new random value so we have not used any of it yet
-  cnt=0;
 }
 
 
 
-void PRNG::next()
+void PRNG::increment()
 {
-  // Increment state
   for (int i = 0; i < PIPELINES; i++)
     {
       int64_t* s = (int64_t*)&state[i*AES_BLK_SIZE];
@@ -145,10 +150,34 @@ void PRNG::next()
       if (s[0] == 0)
           s[1]++;
     }
+}
+
+
+void PRNG::next()
+{
+  increment();
   hash();
 }
 
 
+void PRNG::next(octet* output, int n_blocks)
+{
+  // AES output uses aligned stores
+  bool aligned = (size_t(output) % 16) == 0;
+  for (int i = 0; i < n_blocks; i++)
+    {
+      increment();
+      if (aligned)
+        hash(output + i * RAND_SIZE);
+      else
+        {
+          hash(random);
+          memcpy(output + i * RAND_SIZE, random, RAND_SIZE);
+        }
+    }
+}
+
+
 unsigned int PRNG::get_uint()
 {
   // We need four bytes of randomness
@@ -68,7 +68,11 @@ class PRNG
    bool initialized;
 
    void hash(); // Hashes state to random and sets cnt=0
+   void hash(octet* output);
+   void increment();
    void next();
+   // Writes the next n_blocks values directly to output
+   void next(octet* output, int n_blocks);
 
    public:
 
@@ -240,7 +244,18 @@ inline void PRNG::get_octets(octet* ans,int len)
       len-=step;
       cnt+=step;
       if (cnt==RAND_SIZE)
-        next();
+        {
+          // bypass the buffer for whole values but keep at least one byte
+          // for the buffer to maintain the same stream
+          if (len > RAND_SIZE)
+            {
+              int n_blocks = (len - 1) / RAND_SIZE;
+              next(ans + pos, n_blocks);
+              pos += n_blocks * RAND_SIZE;
+              len -= n_blocks * RAND_SIZE;
+            }
+          next();
+        }
     }
 }
 
@@ -0,0 +1,98 @@
+/*
+ * yao-gate-benchmark.cpp
+ *
+ * Compares the size and speed of AND gates with half-gate and
+ * three-halves garbling and checks the evaluation on random inputs.
+ */
+
+#include "Yao/YaoHalfGate.h"
+#include "Yao/YaoThreeHalvesGate.h"
+#include "Tools/MMO.hpp"
+#include "Tools/time-func.h"
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+template<class T>
+double benchmark(const string& name, int n_gates)
+{
+    PRNG G;
+    G.ReSeed();
+    MMO mmo;
+
+    Key delta = G.get_doubleword();
+    delta.set_signal(1);
+    Key left_delta = delta.doubling(1);
+    Key right_delta = delta.doubling(2);
+
+    vector<YaoGarbleWire> left(n_gates), right(n_gates), out(n_gates);
+    for (int i = 0; i < n_gates; i++)
+    {
+        left[i].randomize(G);
+        right[i].randomize(G);
+    }
+
+    vector<T> gates(n_gates);
+    Timer garble_timer;
+    garble_timer.start();
+    for (int i = 0; i < n_gates; i++)
+    {
+        Key labels[T::N_GARBLE_HASHES], hashes[T::N_GARBLE_HASHES];
+        T::E_inputs(labels, left[i], right[i], left_delta, right_delta, i);
+        mmo.hash<T::N_GARBLE_HASHES>(hashes, labels);
+        T::randomize(out[i], G);
+        gates[i].and_garble(out[i], hashes, left[i], right[i], delta);
+    }
+    garble_timer.stop();
+
+    vector<YaoEvalWire> eval_left(n_gates), eval_right(n_gates),
+            eval_out(n_gates);
+    vector<bool> a(n_gates), b(n_gates);
+    for (int i = 0; i < n_gates; i++)
+    {
+        a[i] = G.get_bit();
+        b[i] = G.get_bit();
+        eval_left[i].set(left[i].full_key() ^ (a[i] ? delta : Key(0)));
+        eval_right[i].set(right[i].full_key() ^ (b[i] ? delta : Key(0)));
+    }
+
+    Timer eval_timer;
+    eval_timer.start();
+    for (int i = 0; i < n_gates; i++)
+    {
+        Key labels[T::N_EVAL_HASHES], hashes[T::N_EVAL_HASHES];
+        T::eval_inputs(labels, eval_left[i].key(), eval_right[i].key(), i);
+        mmo.hash<T::N_EVAL_HASHES>(hashes, labels);
+        gates[i].eval(eval_out[i], hashes, eval_left[i], eval_right[i]);
+    }
+    eval_timer.stop();
+
+    for (int i = 0; i < n_gates; i++)
+        if (not (eval_out[i].key()
+                == (out[i].full_key() ^ (a[i] and b[i] ? delta : Key(0)))))
+        {
+            cerr << name << ": wrong evaluation of gate " << i << endl;
+            exit(1);
+        }
+
+    cout << name << ": " << sizeof(T) << " bytes per gate, "
+            << sizeof(T) * n_gates / 1e6 << " MB in total, "
+            << garble_timer.elapsed() * 1e9 / n_gates << " ns garbling, "
+            << eval_timer.elapsed() * 1e9 / n_gates << " ns evaluation"
+            << endl;
+    return sizeof(T);
+}
+
+int main(int argc, char** argv)
+{
+    int n_gates = 1000000;
+    if (argc > 1)
+        n_gates = atoi(argv[1]);
+
+    double half = benchmark<YaoHalfGate>("half gates", n_gates);
+    double three_halves = benchmark<YaoThreeHalvesGate>("three halves",
+            n_gates);
+    cout << "Communication saving: " << 100 * (1 - three_halves / half)
+            << "%" << endl;
+}
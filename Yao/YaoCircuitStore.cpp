@@ -0,0 +1,139 @@
+/*
+ * YaoCircuitStore.cpp
+ *
+ */
+
+#include "YaoCircuitStore.h"
+#include "Math/Setup.h"
+#include "Tools/Exceptions.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+string yao_circuit_filename(const string& progname, const string& role,
+		int thread_num)
+{
+	string res = PREP_DIR "Yao-" + role + "-" + progname;
+	if (thread_num >= 0)
+		res += "-T" + to_string(thread_num);
+	return res;
+}
+
+YaoCircuitStore::~YaoCircuitStore()
+{
+	close();
+}
+
+void YaoCircuitStore::open_write(const string& filename)
+{
+	this->filename = filename;
+	out.open(filename, ios::binary | ios::trunc);
+	if (not out.good())
+		throw file_error("cannot write to " + filename);
+}
+
+void YaoCircuitStore::open_read(const string& filename)
+{
+	this->filename = filename;
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw file_error("cannot read " + filename
+				+ ", run with --store-circuits first");
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+		throw file_error("cannot stat " + filename);
+	size = st.st_size;
+	pos = 0;
+	if (size > 0)
+	{
+		data = (char*) mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			data = 0;
+			throw file_error("cannot map " + filename);
+		}
+		madvise(data, size, MADV_SEQUENTIAL);
+	}
+	::close(fd);
+}
+
+void YaoCircuitStore::push(ReceivedMsg& gates, ReceivedMsg& masks)
+{
+	for (auto msg : {&gates, &masks})
+	{
+		size_t len = msg->left();
+		out.write((char*) &len, sizeof(len));
+		out.write(msg->consume(len), len);
+	}
+	if (not out.good())
+		throw file_error("cannot write to " + filename);
+}
+
+void YaoCircuitStore::pop(ReceivedMsg& msg)
+{
+	size_t len;
+	if (pos + sizeof(len) > size)
+		throw IO_Error("truncated circuit file " + filename);
+	memcpy(&len, data + pos, sizeof(len));
+	pos += sizeof(len);
+	if (pos + len > size)
+		throw IO_Error("truncated circuit file " + filename);
+	msg.resize(len);
+	avx_memcpy(msg.data(), data + pos, len);
+	pos += len;
+}
+
+bool YaoCircuitStore::pop(ReceivedMsg& gates, ReceivedMsg& masks)
+{
+	if (pos == size)
+		return false;
+	pop(gates);
+	pop(masks);
+	return true;
+}
+
+void YaoCircuitStore::close(bool remove)
+{
+	if (out.is_open())
+		out.close();
+	if (data)
+	{
+		munmap(data, size);
+		data = 0;
+	}
+	if (remove and not filename.empty())
+		::remove(filename.c_str());
+}
+
+size_t YaoInputRecord::n_inputs_from(int from) const
+{
+	size_t res = 0;
+	for (auto& entry : entries)
+		if (entry[0] == from)
+			res += entry[1];
+	return res;
+}
+
+void YaoInputRecord::pack(octetStream& os) const
+{
+	os.store(entries.size());
+	for (auto& entry : entries)
+		for (int x : entry)
+			os.store(x);
+	for (auto& key : keys)
+		os.serialize(key);
+}
+
+void YaoInputRecord::unpack(octetStream& os)
+{
+	entries.resize(os.get<size_t>());
+	for (auto& entry : entries)
+		for (int& x : entry)
+			os.get(x);
+	keys.resize(n_inputs_from(0) + n_inputs_from(1));
+	for (auto& key : keys)
+		os.unserialize(key);
+}
@@ -0,0 +1,74 @@
+/*
+ * YaoCircuitStore.h
+ *
+ */
+
+#ifndef YAO_YAOCIRCUITSTORE_H_
+#define YAO_YAOCIRCUITSTORE_H_
+
+#include "BMR/Key.h"
+#include "Tools/FlexBuffer.h"
+#include "Tools/octetStream.h"
+
+#include <fstream>
+#include <array>
+#include <vector>
+#include <string>
+using namespace std;
+
+enum YaoCircuitMode
+{
+	LIVE_CIRCUITS,
+	STORE_CIRCUITS,
+	LOAD_CIRCUITS,
+};
+
+string yao_circuit_filename(const string& progname, const string& role,
+		int thread_num = -1);
+
+/*
+ * Garbled gates and output masks as received from the garbler,
+ * appended to a file and read back from a memory mapping.
+ */
+class YaoCircuitStore
+{
+	string filename;
+	ofstream out;
+	char* data;
+	size_t size, pos;
+
+	void pop(ReceivedMsg& msg);
+
+public:
+	YaoCircuitStore() : data(0), size(0), pos(0) {}
+	~YaoCircuitStore();
+
+	void open_write(const string& filename);
+	void open_read(const string& filename);
+
+	void push(ReceivedMsg& gates, ReceivedMsg& masks);
+	bool pop(ReceivedMsg& gates, ReceivedMsg& masks);
+
+	void close(bool remove = false);
+};
+
+/*
+ * Wire labels for the inputs of one input instruction
+ * as chosen by the garbler in advance.
+ * The garbler needs the parameters of its own inputs
+ * to read the values in the online phase.
+ */
+class YaoInputRecord
+{
+public:
+	// player, number of bits, fixed-point shift
+	vector<array<int, 3>> entries;
+	vector<Key> keys;
+
+	size_t n_inputs_from(int from) const;
+
+	void pack(octetStream& os) const;
+	void unpack(octetStream& os);
+};
+
+#endif /* YAO_YAOCIRCUITSTORE_H_ */
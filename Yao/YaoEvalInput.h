@@ -25,6 +25,10 @@ public:
 
 	void exchange()
 	{
+		// the garbler only answers after sending all gates
+		if (not evaluator.continuous()
+				and evaluator.circuit_mode() != LOAD_CIRCUITS)
+			evaluator.receive_to_store(*evaluator.P);
 		evaluator.ot_ext.extend_correlated(inputs.size(), inputs);
 		evaluator.player.receive(os);
 	}
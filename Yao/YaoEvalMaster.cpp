@@ -15,8 +15,10 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts) :
-        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous)
+YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts,
+        YaoCircuitMode circuit_mode) :
+        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous),
+        circuit_mode(circuit_mode)
 {
 }
 
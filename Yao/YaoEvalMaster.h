@@ -9,13 +9,16 @@
 #include "GC/ThreadMaster.h"
 #include "GC/Secret.h"
 #include "YaoEvalWire.h"
+#include "YaoCircuitStore.h"
 
 class YaoEvalMaster : public GC::ThreadMaster<GC::Secret<YaoEvalWire>>
 {
 public:
     bool continuous;
+    YaoCircuitMode circuit_mode;
 
-    YaoEvalMaster(bool continuous, OnlineOptions& opts);
+    YaoEvalMaster(bool continuous, OnlineOptions& opts,
+            YaoCircuitMode circuit_mode = LIVE_CIRCUITS);
 
     GC::Thread<GC::Secret<YaoEvalWire>>* new_thread(int i);
 };
@@ -46,6 +46,7 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 	}
 
 	processor.complexity += total;
+	party.wait_for_gates(total);
 	int i_thread = 0, start = 0;
 	for (auto& x : party.get_splits(args, threshold, total))
 	{
@@ -70,7 +71,7 @@ void YaoEvalWire::and_singlethread(GC::Processor<GC::Secret<YaoEvalWire> >& proc
 	processor.complexity += total_ands;
 	size_t n_args = args.size();
 	YaoEvaluator& party = YaoEvaluator::s();
-	YaoGate* gate = (YaoGate*) party.gates.consume(total_ands * sizeof(YaoGate));
+	YaoGate* gate = party.get_gates(total_ands);
 	long counter = party.get_gate_id();
 	map<string, Timer> timers;
 	SeededPRNG prng;
@@ -159,6 +160,12 @@ void YaoEvalWire::finalize_input(T& inputter, int from, int n_bits)
 				inputter.inputs.get_bit(i_bit));
 		i_bit++;
 	}
+	else if (inputter.evaluator.circuit_mode() == LOAD_CIRCUITS)
+	{
+		Key key;
+		inputter.os.unserialize(key);
+		set(key);
+	}
 	else
 	{
 		set(0);
@@ -195,7 +202,7 @@ void YaoEvalWire::op(const YaoEvalWire& left, const YaoEvalWire& right,
 bool YaoEvalWire::get_output()
 {
 	YaoEvaluator::s().taint();
-	bool res = external() ^ YaoEvaluator::s().output_masks.pop_front();
+	bool res = external() ^ YaoEvaluator::s().pop_output_mask();
 #ifdef DEBUG
     cout << "output " << res << " mask " << (external() ^ res) << " external() "
             << external() << endl;
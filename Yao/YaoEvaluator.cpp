@@ -20,6 +20,7 @@ YaoEvaluator::YaoEvaluator(int thread_num, YaoEvalMaster& master) :
 		Thread<GC::Secret<YaoEvalWire>>(thread_num, master),
 		YaoCommon<YaoEvalWire>(master),
 		master(master),
+		all_received(false),
 		player(N, 0, "thread" + to_string(thread_num)),
 		ot_ext(OTExtensionWithMatrix::setup(player, {}, RECEIVER, true))
 {
@@ -31,14 +32,43 @@ void YaoEvaluator::pre_run()
 {
 	if (master.opts.cmd_private_output_file.empty())
 		processor.out.activate(not continuous());
-	if (not continuous())
-		receive_to_store(*P);
+
+	string filename = yao_circuit_filename(master.opts.progname, "Evaluator",
+			thread_num);
+	switch (circuit_mode())
+	{
+	case STORE_CIRCUITS:
+	{
+		ReceivedMsg more_gates, more_masks;
+		circuit_store.open_write(filename);
+		while (receive(*P, more_gates, more_masks))
+			circuit_store.push(more_gates, more_masks);
+		circuit_store.close();
+		break;
+	}
+	case LOAD_CIRCUITS:
+		circuit_store.open_read(filename);
+		break;
+	default:
+		break;
+	}
+}
+
+void YaoEvaluator::post_run()
+{
+	// garbled circuits must not be reused
+	if (circuit_mode() == LOAD_CIRCUITS)
+		circuit_store.close(true);
 }
 
 void YaoEvaluator::run(GC::Program& program)
 {
 	singleton = this;
 
+	// nothing to evaluate without inputs
+	if (circuit_mode() == STORE_CIRCUITS)
+		return;
+
 	if (continuous())
 		run(program, *P);
 	else
@@ -52,7 +82,8 @@ void YaoEvaluator::run(GC::Program& program, Player& P)
 	auto next = GC::TIME_BREAK;
 	do
 	{
-		receive(P);
+		if (not all_received)
+			receive(P);
 		try
 		{
 			next = program.execute(processor, master.memory, -1);
@@ -67,36 +98,75 @@ void YaoEvaluator::run(GC::Program& program, Player& P)
 void YaoEvaluator::run_from_store(GC::Program& program)
 {
 	machine.reset_timer();
-	do
-	{
-		gates_store.pop(gates);
-		output_masks_store.pop(output_masks);
-	}
-	while(GC::DONE_BREAK != program.execute(processor, master.memory, -1));
+	while(GC::DONE_BREAK != program.execute(processor, master.memory, -1))
+		;
 }
 
-bool YaoEvaluator::receive(Player& P)
+bool YaoEvaluator::receive(Player& P, ReceivedMsg& more_gates,
+		ReceivedMsg& more_masks)
 {
 #ifdef DEBUG_YAO
 	printf("waiting to receive at %d in thread %d\n", processor.PC, thread_num);
 #endif
-	if (P.receive_long(0) == YaoCommon::DONE)
+	if (all_received or P.receive_long(0) == YaoCommon::DONE)
+	{
+		all_received = true;
 		return false;
-	P.receive_player(0, gates);
-	P.receive_player(0, output_masks);
+	}
+	P.receive_player(0, more_gates);
+	P.receive_player(0, more_masks);
 #ifdef DEBUG_YAO
-	cout << "received " << gates.size() << " bytes for gates and "
-			<< output_masks.size() << " output masks at " << processor.PC
+	cout << "received " << more_gates.size() << " bytes for gates and "
+			<< more_masks.size() << " output masks at " << processor.PC
 			<< " in thread " << thread_num << endl;
 #endif
 	return true;
 }
 
+bool YaoEvaluator::receive(Player& P)
+{
+	ReceivedMsg more_gates, more_masks;
+	bool res = receive(P, more_gates, more_masks);
+	gates.append(more_gates);
+	output_masks.append(more_masks);
+	return res;
+}
+
+/*
+ * Garbled gates arrive in chunks, which are appended
+ * to the unused gates as they are needed.
+ */
+void YaoEvaluator::fetch()
+{
+	if (circuit_mode() == LOAD_CIRCUITS)
+	{
+		ReceivedMsg more_gates, more_masks;
+		if (not circuit_store.pop(more_gates, more_masks))
+			throw runtime_error("stored circuit does not match program");
+		gates.append(more_gates);
+		output_masks.append(more_masks);
+	}
+	else if (gates_store.empty())
+	{
+		if (not receive(*P))
+			throw runtime_error("garbler sent fewer gates than needed");
+	}
+	else
+	{
+		ReceivedMsg more_gates, more_masks;
+		gates_store.pop(more_gates);
+		output_masks_store.pop(more_masks);
+		gates.append(more_gates);
+		output_masks.append(more_masks);
+	}
+}
+
 void YaoEvaluator::receive_to_store(Player& P)
 {
-	while (receive(P))
+	ReceivedMsg more_gates, more_masks;
+	while (receive(P, more_gates, more_masks))
 	{
-		gates_store.push(gates);
-		output_masks_store.push(output_masks);
+		gates_store.push(more_gates);
+		output_masks_store.push(more_masks);
 	}
 }
@@ -9,6 +9,7 @@
 #include "YaoGate.h"
 #include "YaoEvalMaster.h"
 #include "YaoCommon.h"
+#include "YaoCircuitStore.h"
 #include "GC/Secret.h"
 #include "GC/Thread.h"
 #include "Tools/MMO.h"
@@ -24,9 +25,16 @@ protected:
 
 	ReceivedMsg gates;
 	ReceivedMsgStore gates_store;
+	YaoCircuitStore circuit_store;
 
 	YaoEvalMaster& master;
 
+	bool all_received;
+
+	bool receive(Player& P, ReceivedMsg& more_gates, ReceivedMsg& more_masks);
+	void fetch();
+	void make_available(ReceivedMsg& buffer, size_t size);
+
 	friend class YaoCommon<YaoEvalWire>;
 	friend class YaoEvalWire;
 
@@ -44,8 +52,10 @@ public:
 	YaoEvaluator(int thread_num, YaoEvalMaster& master);
 
 	bool continuous() { return master.continuous; }
+	YaoCircuitMode circuit_mode() { return master.circuit_mode; }
 
 	void pre_run();
+	void post_run();
 	void run(GC::Program& program);
 	void run(GC::Program& program, Player& P);
 	void run_from_store(GC::Program& program);
@@ -53,6 +63,9 @@ public:
 	void receive_to_store(Player& P);
 
 	void load_gate(YaoGate& gate);
+	YaoGate* get_gates(size_t n_gates);
+	void wait_for_gates(size_t n_gates);
+	bool pop_output_mask();
 
 	long get_gate_id() { return gate_id(thread_num); }
 
@@ -60,11 +73,35 @@ public:
 	{ return max(1u, thread::hardware_concurrency() / master.machine.nthreads); }
 };
 
+inline void YaoEvaluator::make_available(ReceivedMsg& buffer, size_t size)
+{
+	while (buffer.left() < size)
+		fetch();
+}
+
 inline void YaoEvaluator::load_gate(YaoGate& gate)
 {
+	make_available(gates, sizeof(YaoGate));
 	gates.unserialize(gate);
 }
 
+inline void YaoEvaluator::wait_for_gates(size_t n_gates)
+{
+	make_available(gates, n_gates * sizeof(YaoGate));
+}
+
+inline YaoGate* YaoEvaluator::get_gates(size_t n_gates)
+{
+	wait_for_gates(n_gates);
+	return (YaoGate*) gates.consume(n_gates * sizeof(YaoGate));
+}
+
+inline bool YaoEvaluator::pop_output_mask()
+{
+	make_available(output_masks, 1);
+	return output_masks.pop_front();
+}
+
 inline YaoEvaluator& YaoEvaluator::s()
 {
 	if (singleton)
@@ -15,13 +15,42 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold) :
-        super(opts), continuous(continuous), threshold(threshold)
+YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts,
+        int threshold, int chunk_size, YaoCircuitMode circuit_mode) :
+        super(opts), continuous(continuous), threshold(threshold),
+        chunk_size(chunk_size), circuit_mode(circuit_mode)
 {
+    // stored circuits only work with the same offset
+    string filename = yao_circuit_filename(opts.progname, "Garbler");
+    if (circuit_mode == LOAD_CIRCUITS)
+    {
+        octetStream os;
+        os.input(filename);
+        os.unserialize(delta);
+        return;
+    }
+
     PRNG G;
     G.ReSeed();
     delta = G.get_doubleword();
     delta.set_signal(1);
+
+    if (circuit_mode == STORE_CIRCUITS)
+    {
+        octetStream os;
+        os.serialize(delta);
+        ofstream out(filename);
+        os.output(out);
+        if (not out.good())
+            throw file_error("cannot write to " + filename);
+    }
+}
+
+YaoGarbleMaster::~YaoGarbleMaster()
+{
+    // garbled circuits must not be reused
+    if (circuit_mode == LOAD_CIRCUITS)
+        remove(yao_circuit_filename(opts.progname, "Garbler").c_str());
 }
 
 GC::Thread<GC::Secret<YaoGarbleWire>>* YaoGarbleMaster::new_thread(int i)
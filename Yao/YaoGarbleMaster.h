@@ -9,6 +9,7 @@
 #include "GC/ThreadMaster.h"
 #include "GC/Secret.h"
 #include "YaoGarbleWire.h"
+#include "YaoCircuitStore.h"
 #include "Processor/OnlineOptions.h"
 
 class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
@@ -20,8 +21,12 @@ class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
 public:
     bool continuous;
     int threshold;
+    int chunk_size;
+    YaoCircuitMode circuit_mode;
 
-    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024);
+    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024,
+            int chunk_size = 10000, YaoCircuitMode circuit_mode = LIVE_CIRCUITS);
+    ~YaoGarbleMaster();
 
     GC::Thread<GC::Secret<YaoGarbleWire>>* new_thread(int i);
 
@@ -57,6 +57,7 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 	processor.complexity += total;
 	SendBuffer& gates = party.gates;
 	gates.allocate(total * sizeof(YaoGate));
+	vector<size_t> job_ends;
 	int i_thread = 0, start = 0;
 	for (auto& x : party.get_splits(args, party.get_threshold(), total))
 	{
@@ -64,6 +65,7 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 		int end = x[1];
 		YaoGate* gate = (YaoGate*)gates.end();
 		gates.skip(i_gate * sizeof(YaoGate));
+		job_ends.push_back(gates.size());
 		party.timers["Dispatch"].start();
 		party.jobs[i_thread++]->dispatch(YAO_AND_JOB, processor, args, start,
 				end, i_gate, gate, party.get_gate_id(), repeat);
@@ -74,7 +76,12 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 	}
 	party.and_prepare_timer.stop();
 	party.and_wait_timer.start();
-	party.wait(i_thread);
+	// pass on gates as soon as they are garbled
+	for (int i = 0; i < i_thread; i++)
+	{
+		party.jobs[i]->worker.done();
+		party.send_if_ready(job_ends[i]);
+	}
 	party.and_wait_timer.stop();
 }
 
@@ -93,6 +100,7 @@ void YaoGarbleWire::and_singlethread(GC::Processor<GC::Secret<YaoGarbleWire> >&
 	and_(processor.S, args, 0, n_args, total_ands, gate, counter,
 			garbler.prng, garbler.timers, repeat, garbler);
 	garbler.counter += counter - garbler.get_gate_id();
+	garbler.send_if_ready(gates.size());
 }
 
 void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
@@ -105,8 +113,8 @@ void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
 	int dl = GC::Secret<YaoGarbleWire>::default_length;
 	Key left_delta = delta.doubling(1);
 	Key right_delta = delta.doubling(2);
-	Key labels[4];
-	Key hashes[4];
+	Key labels[YaoGate::N_GARBLE_HASHES];
+	Key hashes[YaoGate::N_GARBLE_HASHES];
 	MMO& mmo = garbler.mmo;
 	for (auto it = args.begin() + start; it < args.begin() + end; it += 4)
 	{
@@ -116,7 +124,7 @@ void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
 			YaoGate::E_inputs(labels, S[*(it + 2)].get_reg(0),
 					S[*(it + 3)].get_reg(0), left_delta, right_delta,
 					counter);
-			mmo.hash<4>(hashes, labels);
+			mmo.hash<YaoGate::N_GARBLE_HASHES>(hashes, labels);
 			auto& out = S[*(it + 1)];
 			out.resize_regs(1);
 			YaoGate::randomize(out.get_reg(0), prng);
@@ -140,11 +148,11 @@ void YaoGarbleWire::and_(StackedVector<GC::Secret<YaoGarbleWire> >& S,
 					counter++;
 					YaoGate::E_inputs(labels, left_wire,
 							right_wire, left_delta, right_delta, counter);
-					mmo.hash<4>(hashes, labels);
+					mmo.hash<YaoGate::N_GARBLE_HASHES>(hashes, labels);
 					//timers["Inner ref"].start();
 					//timers["Inner ref"].stop();
 					//timers["Randomizing"].start();
-					out.get_reg(k).randomize(prng);
+					YaoGate::randomize(out.get_reg(k), prng);
 					//timers["Randomizing"].stop();
 					//timers["Gate computation"].start();
 					(gate++)->and_garble(out.get_reg(k), hashes,
@@ -162,6 +170,26 @@ void YaoGarbleWire::inputb(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
         const vector<int>& args)
 {
 	auto& garbler = YaoGarbler::s();
+	if (garbler.circuit_mode() == STORE_CIRCUITS)
+	{
+		// labels independent of the inputs
+		int dl = whole_type::default_length;
+		YaoInputRecord record;
+		for (auto x : InputArgList(args))
+		{
+			record.entries.push_back({{x.from, x.n_bits, x.n_shift}});
+			for (int i = 0; i < x.n_bits; i++)
+			{
+				auto& dest = processor.S[x.dest + i / dl];
+				if (i % dl == 0)
+					dest.resize_regs(min(dl, x.n_bits - i));
+				garbler.offline_input(dest.get_reg(i % dl), record, x.from);
+			}
+		}
+		garbler.store_inputs(record);
+		return;
+	}
+
 	YaoGarbleInput input;
 	processor.inputb(input, processor, args, garbler.P->my_num());
 }
@@ -170,6 +198,23 @@ void YaoGarbleWire::inputbvec(GC::Processor<GC::Secret<YaoGarbleWire>>& processo
         ProcessorBase& input_processor, const vector<int>& args)
 {
     auto& garbler = YaoGarbler::s();
+    if (garbler.circuit_mode() == STORE_CIRCUITS)
+    {
+        YaoInputRecord record;
+        for (auto x : InputVecArgList(args))
+        {
+            record.entries.push_back({{x.from, x.n_bits, x.n_shift}});
+            for (int i = 0; i < x.n_bits; i++)
+            {
+                auto& dest = processor.S[x.dest[i]];
+                dest.resize_regs(1);
+                garbler.offline_input(dest.get_reg(0), record, x.from);
+            }
+        }
+        garbler.store_inputs(record);
+        return;
+    }
+
     YaoGarbleInput input;
     processor.inputbvec(input, input_processor, args, *garbler.P);
 }
@@ -202,6 +247,8 @@ void YaoGarbleWire::convcbit(Integer& dest, const GC::Clear& source,
 	auto &garbler = YaoGarbler::s();
 	if (garbler.continuous())
 		dest = source;
+	else if (garbler.circuit_mode() == STORE_CIRCUITS)
+		throw runtime_error("run-time branching impossible with stored circuits");
 	else
 	{
 		garbler.untaint();
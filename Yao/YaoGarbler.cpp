@@ -21,6 +21,7 @@ YaoGarbler::YaoGarbler(int thread_num, YaoGarbleMaster& master) :
 		GC::Thread<GC::Secret<YaoGarbleWire>>(thread_num, master),
 		YaoCommon<YaoGarbleWire>(master),
 		master(master),
+		gates_sent(0),
 		and_proc_timer(CLOCK_PROCESS_CPUTIME_ID),
 		and_main_thread_timer(CLOCK_THREAD_CPUTIME_ID),
 		player(master.N, 1, "thread" + to_string(thread_num)),
@@ -39,6 +40,15 @@ YaoGarbler::YaoGarbler(int thread_num, YaoGarbleMaster& master) :
 			cerr << "Garbling party cannot output with one-shot computation"
 					<< endl;
 	}
+
+	if (circuit_mode() == STORE_CIRCUITS)
+	{
+		string filename = yao_circuit_filename(master.opts.progname,
+				"Garbler", thread_num);
+		input_records.open(filename, ios::out | ios::binary | ios::trunc);
+		if (not input_records.good())
+			throw file_error("cannot write to " + filename);
+	}
 }
 
 YaoGarbler::~YaoGarbler()
@@ -57,10 +67,20 @@ YaoGarbler::~YaoGarbler()
 #endif
 }
 
+void YaoGarbler::pre_run()
+{
+	if (circuit_mode() == LOAD_CIRCUITS)
+		process_stored_inputs();
+}
+
 void YaoGarbler::run(GC::Program& program)
 {
 	singleton = this;
 
+	// the circuits have been garbled before
+	if (circuit_mode() == LOAD_CIRCUITS)
+		return;
+
 	GC::BreakType b = GC::TIME_BREAK;
 	while(GC::DONE_BREAK != b)
 	{
@@ -75,8 +95,6 @@ void YaoGarbler::run(GC::Program& program)
 			processor.PC--;
 		}
 		send(*P);
-		gates.clear();
-		output_masks.clear();
 		if (continuous())
 			process_receiver_inputs();
 	}
@@ -84,7 +102,7 @@ void YaoGarbler::run(GC::Program& program)
 
 void YaoGarbler::post_run()
 {
-	if (not continuous())
+	if (not continuous() and circuit_mode() != LOAD_CIRCUITS)
 	{
 		P->send_long(1, YaoCommon::DONE);
 		process_receiver_inputs();
@@ -92,17 +110,50 @@ void YaoGarbler::post_run()
 }
 
 void YaoGarbler::send(Player& P)
+{
+	send(P, gates.size());
+}
+
+void YaoGarbler::send(Player& P, size_t end)
 {
 #ifdef DEBUG_YAO
-	cerr << "sending " << gates.size() << " bytes for gates and "
+	cerr << "sending " << end - gates_sent << " bytes for gates and "
 			<< output_masks.size() << " output masks at " << processor.PC
 			<< " in thread " << thread_num << endl;
 #endif
 	P.send_long(1, YaoCommon::MORE);
-	size_t size = gates.size();
-	P.send_to(1, gates);
-	gates.allocate(2 * size);
+	if (gates_sent == 0 and end == gates.size())
+	{
+		size_t size = gates.size();
+		P.send_to(1, gates);
+		gates.allocate(2 * size);
+	}
+	else
+	{
+		// later gates might still be in the making
+		P.send_to(1, octetStream(end - gates_sent,
+				(octet*) gates.data() + gates_sent));
+		gates_sent = end;
+		if (gates_sent == gates.size())
+		{
+			gates.clear();
+			gates_sent = 0;
+		}
+	}
 	P.send_to(1, output_masks);
+	output_masks.clear();
+}
+
+/*
+ * Sends garbled gates up to byte offset end
+ * if they amount to at least one chunk.
+ * This allows the evaluator to start before the end of a batch.
+ */
+void YaoGarbler::send_if_ready(size_t end)
+{
+	if (master.chunk_size > 0
+			and end - gates_sent >= master.chunk_size * sizeof(YaoGate))
+		send(*P, end);
 }
 
 void YaoGarbler::process_receiver_inputs()
@@ -121,3 +172,73 @@ void YaoGarbler::process_receiver_inputs()
 		receiver_input_keys.pop_front();
 	}
 }
+
+void YaoGarbler::offline_input(YaoGarbleWire& wire, YaoInputRecord& record,
+		int from)
+{
+	if (from == P->my_num())
+		wire.randomize(prng);
+	else
+		wire.set(prng.get_doubleword(), 0);
+	record.keys.push_back(wire.full_key());
+}
+
+void YaoGarbler::store_inputs(const YaoInputRecord& record)
+{
+	octetStream os;
+	record.pack(os);
+	os.output(input_records);
+	if (not input_records.good())
+		throw runtime_error("cannot store input labels");
+}
+
+/*
+ * Sends the labels for all inputs of this thread in the order of
+ * the stored circuits. Only this needs the inputs of the garbler.
+ */
+void YaoGarbler::process_stored_inputs()
+{
+	string filename = yao_circuit_filename(master.opts.progname, "Garbler",
+			thread_num);
+	input_records.open(filename, ios::in | ios::binary);
+	if (not input_records.good())
+		throw file_error("cannot read " + filename
+				+ ", run with --store-circuits first");
+
+	octetStream os;
+	YaoInputRecord record;
+	while (input_records.peek() != EOF)
+	{
+		os.input(input_records);
+		record.unpack(os);
+
+		BitVector _;
+		ot_ext.extend_correlated(record.n_inputs_from(1), _);
+
+		octetStream labels;
+		auto key = record.keys.begin();
+		size_t i_ot = 0;
+		for (auto& entry : record.entries)
+		{
+			int n_bits = entry[1];
+			if (entry[0] == P->my_num())
+			{
+				bigint value = processor.get_long_input<bigint>(&entry[1],
+						processor, false);
+				for (int i = 0; i < n_bits; i++)
+					labels.serialize(
+							*key++
+									^ ((bigint(value >> i).get_si() & 1) ?
+											get_delta() : 0));
+			}
+			else
+				for (int i = 0; i < n_bits; i++)
+					labels.serialize(
+							*key++ ^ ot_ext.senderOutputMatrices[0][i_ot++]);
+		}
+		player.send(labels);
+	}
+
+	input_records.close();
+	remove(filename.c_str());
+}
@@ -10,6 +10,7 @@
 #include "YaoAndJob.h"
 #include "YaoGarbleMaster.h"
 #include "YaoCommon.h"
+#include "YaoCircuitStore.h"
 #include "Tools/random.h"
 #include "Tools/MMO.h"
 #include "GC/Secret.h"
@@ -32,6 +33,9 @@ protected:
 	YaoGarbleMaster& master;
 
 	SendBuffer gates;
+	size_t gates_sent;
+
+	fstream input_records;
 
 	Timer and_timer;
 	Timer and_proc_timer;
@@ -57,14 +61,22 @@ public:
 	~YaoGarbler();
 
 	bool continuous() { return master.continuous; }
+	YaoCircuitMode circuit_mode() { return master.circuit_mode; }
 
+	void pre_run();
 	void run(GC::Program& program);
 	void run(Player& P, bool continuous);
 	void post_run();
 	void send(Player& P);
+	void send(Player& P, size_t end);
+	void send_if_ready(size_t end);
 
 	void process_receiver_inputs();
 
+	void offline_input(YaoGarbleWire& wire, YaoInputRecord& record, int from);
+	void store_inputs(const YaoInputRecord& record);
+	void process_stored_inputs();
+
 	Key get_delta() { return master.get_delta(); }
 	void store_gate(const YaoGate& gate);
 
@@ -16,6 +16,7 @@ class YaoHalfGate
 
 public:
 	static const int N_EVAL_HASHES = 2;
+	static const int N_GARBLE_HASHES = 4;
 
 	static void eval_inputs(Key* output, const Key& left, const Key& right,
 			long T);
@@ -41,28 +41,70 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 	        "-b", // Flag token.
 	        "--batch-size" // Flag token.
 	);
+	opt.add(
+	        "10000", // Default.
+	        0, // Required?
+	        1, // Number of args expected.
+	        0, // Delimiter if expecting multiple args.
+	        "Number of garbled gates to send at once, 0 for sending "
+	        "only at the end of batches (default: 10000)", // Help description.
+	        "-c", // Flag token.
+	        "--chunk-size" // Flag token.
+	);
+	opt.add(
+	        "", // Default.
+	        0, // Required?
+	        0, // Number of args expected.
+	        0, // Delimiter if expecting multiple args.
+	        "Garble the circuits without inputs and store them "
+	        "for later use with --load-circuits (implies -O)", // Help description.
+	        "-sc", // Flag token.
+	        "--store-circuits" // Flag token.
+	);
+	opt.add(
+	        "", // Default.
+	        0, // Required?
+	        0, // Number of args expected.
+	        0, // Delimiter if expecting multiple args.
+	        "Evaluate circuits stored by --store-circuits, "
+	        "only exchanging input labels (implies -O)", // Help description.
+	        "-lc", // Flag token.
+	        "--load-circuits" // Flag token.
+	);
 	auto& online_opts = OnlineOptions::singleton;
 	online_opts = {opt, argc, argv, false};
 	NetworkOptionsWithNumber network_opts(opt, argc, argv, 2, false);
 	online_opts.finalize(opt, argc, argv);
 
 	int my_num = online_opts.playerno;
-	int threshold;
-	bool continuous = not opt.get("-O")->isSet;
+	int threshold, chunk_size;
+	YaoCircuitMode circuit_mode = LIVE_CIRCUITS;
+	if (opt.isSet("--store-circuits"))
+		circuit_mode = STORE_CIRCUITS;
+	if (opt.isSet("--load-circuits"))
+	{
+		if (circuit_mode == STORE_CIRCUITS)
+			throw runtime_error("cannot store and load circuits at once");
+		circuit_mode = LOAD_CIRCUITS;
+	}
+	bool continuous = not opt.get("-O")->isSet
+			and circuit_mode == LIVE_CIRCUITS;
 	opt.get("-t")->getInt(threshold);
+	opt.get("-c")->getInt(chunk_size);
 	opt.get("-b")->getInt(online_opts.batch_size);
 	progname = online_opts.progname;
 
 	GC::ThreadMasterBase* master;
 	if (my_num == 0)
-	    master = new YaoGarbleMaster(continuous, online_opts, threshold);
+	    master = new YaoGarbleMaster(continuous, online_opts, threshold,
+	            chunk_size, circuit_mode);
 	else
-	    master = new YaoEvalMaster(continuous, online_opts);
+	    master = new YaoEvalMaster(continuous, online_opts, circuit_mode);
 
 	network_opts.start_networking(master->N, my_num);
 	master->run(progname);
 
-	if (my_num == 1)
+	if (my_num == 1 and circuit_mode != STORE_CIRCUITS)
 	    ((YaoEvalMaster*)master)->machine.write_memory(0);
 
 	delete master;
@@ -0,0 +1,65 @@
+/*
+ * YaoThreeHalvesGate.cpp
+ *
+ */
+
+#include "YaoThreeHalvesGate.h"
+#include "YaoGarbler.h"
+#include "YaoEvaluator.h"
+
+/*
+ * Control matrices by signal of the zero labels and random choice.
+ * Bit 4 * row + column selects the half of the input labels
+ * (left low, left high, right low, right high) contributing
+ * to output half row.
+ */
+const YaoThreeHalvesGate::GarbleEntry YaoThreeHalvesGate::garble_table[64] = {
+	{0x00,0x04,0x20,0x0000},{0x7e,0x04,0x20,0xeeee},{0x97,0x04,0x20,0x1111},{0xe9,0x04,0x20,0xffff},
+	{0x38,0xed,0x5e,0x6897},{0x46,0xed,0x5e,0x8679},{0xaf,0xed,0x5e,0x7986},{0xd1,0xed,0x5e,0x9768},
+	{0x30,0x93,0xc9,0xa5b4},{0x4e,0x93,0xc9,0x4b5a},{0xa7,0x93,0xc9,0xb4a5},{0xd9,0x93,0xc9,0x5a4b},
+	{0x08,0x7a,0xb7,0xcd23},{0x76,0x7a,0xb7,0x23cd},{0x9f,0x7a,0xb7,0xdc32},{0xe1,0x7a,0xb7,0x32dc},
+	{0x28,0x04,0x20,0x3333},{0x56,0x04,0x20,0xdddd},{0xbf,0x04,0x20,0x2222},{0xc1,0x04,0x20,0xcccc},
+	{0x6e,0xed,0x5e,0x5ba4},{0x10,0xed,0x5e,0xb54a},{0xf9,0xed,0x5e,0x4ab5},{0x87,0xed,0x5e,0xa45b},
+	{0xf1,0x93,0xc9,0x9687},{0x8f,0x93,0xc9,0x7869},{0x66,0x93,0xc9,0x8796},{0x18,0x93,0xc9,0x6978},
+	{0xb7,0x7a,0xb7,0xfe10},{0xc9,0x7a,0xb7,0x10fe},{0x20,0x7a,0xb7,0xef01},{0x5e,0x7a,0xb7,0x01ef},
+	{0x3c,0x04,0x20,0x7777},{0x42,0x04,0x20,0x9999},{0xab,0x04,0x20,0x6666},{0xd5,0x04,0x20,0x8888},
+	{0xed,0xed,0x5e,0x1fe0},{0x93,0xed,0x5e,0xf10e},{0x7a,0xed,0x5e,0x0ef1},{0x04,0xed,0x5e,0xe01f},
+	{0x9b,0x93,0xc9,0xd2c3},{0xe5,0x93,0xc9,0x3c2d},{0x0c,0x93,0xc9,0xc3d2},{0x72,0x93,0xc9,0x2d3c},
+	{0x4a,0x7a,0xb7,0xba54},{0x34,0x7a,0xb7,0x54ba},{0xdd,0x7a,0xb7,0xab45},{0xa3,0x7a,0xb7,0x45ab},
+	{0x14,0x04,0x20,0x4444},{0x6a,0x04,0x20,0xaaaa},{0x83,0x04,0x20,0x5555},{0xfd,0x04,0x20,0xbbbb},
+	{0xbb,0xed,0x5e,0x2cd3},{0xc5,0xed,0x5e,0xc23d},{0x2c,0xed,0x5e,0x3dc2},{0x52,0xed,0x5e,0xd32c},
+	{0x5a,0x93,0xc9,0xe1f0},{0x24,0x93,0xc9,0x0f1e},{0xcd,0x93,0xc9,0xf0e1},{0xb3,0x93,0xc9,0x1e0f},
+	{0xf5,0x7a,0xb7,0x8967},{0x8b,0x7a,0xb7,0x6789},{0x62,0x7a,0xb7,0x9876},{0x1c,0x7a,0xb7,0x7698},
+};
+
+// control matrix by signals and decrypted control bits
+const uint8_t YaoThreeHalvesGate::eval_table[4][16] = {
+	{0x00,0x97,0x9f,0x08,0x30,0xa7,0xaf,0x38,0xd1,0x46,0x4e,0xd9,0xe1,0x76,0x7e,0xe9},
+	{0x20,0xb7,0xbf,0x28,0x10,0x87,0x8f,0x18,0xf1,0x66,0x6e,0xf9,0xc1,0x56,0x5e,0xc9},
+	{0x04,0x93,0x9b,0x0c,0x34,0xa3,0xab,0x3c,0xd5,0x42,0x4a,0xdd,0xe5,0x72,0x7a,0xed},
+	{0x24,0xb3,0xbb,0x2c,0x14,0x83,0x8b,0x1c,0xf5,0x62,0x6a,0xfd,0xc5,0x52,0x5a,0xcd},
+};
+
+YaoThreeHalvesGate::YaoThreeHalvesGate(YaoGarbleWire& out,
+		const YaoGarbleWire& left, const YaoGarbleWire& right,
+		Function function)
+{
+	for (int i = 0; i < 4; i++)
+		assert(function[i] == Function(0x0001)[i]);
+	Key labels[N_GARBLE_HASHES];
+	Key hashes[N_GARBLE_HASHES];
+	E_inputs(labels, left, right, YaoGarbler::s().get_delta().doubling(1),
+			{}, YaoGarbler::s().counter);
+	YaoGarbler::s().mmo.hash<N_GARBLE_HASHES>(hashes, labels);
+	and_garble(out, hashes, left, right, YaoGarbler::s().get_delta());
+}
+
+void YaoThreeHalvesGate::eval(YaoEvalWire& out, const YaoEvalWire& left,
+		const YaoEvalWire& right)
+{
+	Key hashes[N_EVAL_HASHES];
+	Key labels[N_EVAL_HASHES];
+	eval_inputs(labels, left.key(), right.key(), YaoEvaluator::s().counter);
+	YaoEvaluator::s().mmo.hash<N_EVAL_HASHES>(hashes, labels);
+	eval(out, hashes, left, right);
+}
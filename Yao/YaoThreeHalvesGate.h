@@ -0,0 +1,192 @@
+/*
+ * YaoThreeHalvesGate.h
+ *
+ */
+
+#ifndef YAO_YAOTHREEHALVESGATE_H_
+#define YAO_YAOTHREEHALVESGATE_H_
+
+#include "BMR/Key.h"
+#include "YaoGarbleWire.h"
+#include "YaoEvalWire.h"
+
+/*
+ * AND gates following the "three halves make a whole" approach
+ * by Rosulek and Roy (Crypto 2021). Labels are split into two
+ * 64-bit halves, the lower one containing the signal bit.
+ * A gate consists of three half-size ciphertexts and
+ * 4 control bits per combination of signals.
+ */
+class YaoThreeHalvesGate
+{
+	struct GarbleEntry
+	{
+		uint8_t S, R1, R2;
+		uint16_t codes;
+	};
+
+	static const GarbleEntry garble_table[64];
+	static const uint8_t eval_table[4][16];
+
+	uint64_t G[3];
+	uint16_t z;
+
+	static uint64_t low(const Key& key)
+	{
+		return _mm_cvtsi128_si64(key.r);
+	}
+
+	static uint64_t high(const Key& key)
+	{
+		return _mm_cvtsi128_si64(_mm_unpackhi_epi64(key.r, key.r));
+	}
+
+	// XOR of the halves selected by the lowest four bits
+	static uint64_t select(int row, const uint64_t* halves)
+	{
+		uint64_t res = 0;
+		for (int i = 0; i < 4; i++)
+			res ^= -uint64_t((row >> i) & 1) & halves[i];
+		return res;
+	}
+
+	static int pad(const Key& a, const Key& b, const Key& c)
+	{
+		return high(a ^ b ^ c) & 0xF;
+	}
+
+public:
+	static const int N_EVAL_HASHES = 3;
+	static const int N_GARBLE_HASHES = 6;
+
+	static void eval_inputs(Key* output, const Key& left, const Key& right,
+			long T);
+	static void E_inputs(Key* output, const YaoGarbleWire& left,
+			const YaoGarbleWire& right, const Key& left_delta,
+			const Key& right_delta, long T);
+	static void randomize(YaoGarbleWire&, PRNG&) {}
+	static Key garble_public_input(bool value, Key delta)
+	{
+		return value ? delta : 0;
+	}
+
+	YaoThreeHalvesGate() {}
+	YaoThreeHalvesGate(YaoGarbleWire&, const YaoGarbleWire&,
+			const YaoGarbleWire&, Function);
+	void and_garble(YaoGarbleWire& out, const Key* hashes,
+			const YaoGarbleWire& left, const YaoGarbleWire& right, Key delta);
+	void eval(YaoEvalWire&, const YaoEvalWire&,
+			const YaoEvalWire&);
+	void eval(YaoEvalWire& out, const Key* hashes, const YaoEvalWire& left,
+			const YaoEvalWire& right);
+} __attribute__((packed));
+
+inline void YaoThreeHalvesGate::E_inputs(Key* output,
+		const YaoGarbleWire& left, const YaoGarbleWire& right,
+		const Key& left_delta, const Key&, long T)
+{
+	auto l = left.full_key().doubling(1);
+	auto r = right.full_key().doubling(1);
+	long j = 3 * T;
+	output[0] = l ^ j;
+	output[1] = output[0] ^ left_delta;
+	output[2] = r ^ (j + 1);
+	output[3] = output[2] ^ left_delta;
+	output[4] = (left.full_key() ^ right.full_key()).doubling(1) ^ (j + 2);
+	output[5] = output[4] ^ left_delta;
+}
+
+inline void YaoThreeHalvesGate::and_garble(YaoGarbleWire& out,
+		const Key* hashes, const YaoGarbleWire& left,
+		const YaoGarbleWire& right, Key delta)
+{
+	bool alpha = left.mask();
+	bool beta = right.mask();
+	Key A0 = left.full_key();
+	Key B0 = right.full_key();
+	uint64_t labels[4] = { low(A0), high(A0), low(B0), high(B0) };
+	uint64_t delta_a[4] = { low(delta), high(delta), 0, 0 };
+	uint64_t delta_b[4] = { 0, 0, low(delta), high(delta) };
+
+	// randomness unknown to the evaluator
+	int choice = (high(hashes[0] ^ hashes[1] ^ hashes[2] ^ hashes[3]
+			^ hashes[4] ^ hashes[5]) >> 4) & 0xF;
+	auto& entry = garble_table[32 * alpha + 16 * beta + choice];
+
+	uint64_t u[2], v[2];
+	for (int i = 0; i < 2; i++)
+	{
+		u[i] = select(entry.R1 >> (4 * i), labels)
+				^ select((entry.S ^ entry.R1) >> (4 * i), delta_a);
+		v[i] = select(entry.R2 >> (4 * i), labels)
+				^ select((entry.S ^ entry.R2) >> (4 * i), delta_b);
+	}
+
+	G[0] = low(hashes[0] ^ hashes[1]) ^ u[0] ^ u[1];
+	G[1] = low(hashes[2] ^ hashes[3]) ^ v[0] ^ v[1];
+	G[2] = low(hashes[4] ^ hashes[5]) ^ u[1];
+
+	z = 0;
+	for (int c = 0; c < 4; c++)
+	{
+		int a = (c >> 1) ^ alpha;
+		int b = (c & 1) ^ beta;
+		int r = ((entry.codes >> (4 * c)) & 0xF)
+				^ pad(hashes[a], hashes[2 + b], hashes[4 + (a ^ b)]);
+		z |= r << (4 * c);
+	}
+
+	// zero label as computed by the evaluator
+	uint64_t K0 = low(hashes[4]);
+	uint64_t out_low = low(hashes[0]) ^ K0 ^ select(entry.S, labels);
+	uint64_t out_high = low(hashes[2]) ^ K0 ^ select(entry.S >> 4, labels);
+	if (alpha)
+	{
+		out_low ^= G[0] ^ G[2];
+		out_high ^= G[2];
+	}
+	if (beta)
+	{
+		out_low ^= G[2];
+		out_high ^= G[1] ^ G[2];
+	}
+	out.set_full_key(Key(out_high, out_low));
+}
+
+inline void YaoThreeHalvesGate::eval_inputs(Key* output, const Key& left,
+		const Key& right, long T)
+{
+	long j = 3 * T;
+	output[0] = left.doubling(1) ^ j;
+	output[1] = right.doubling(1) ^ (j + 1);
+	output[2] = (left ^ right).doubling(1) ^ (j + 2);
+}
+
+inline void YaoThreeHalvesGate::eval(YaoEvalWire& out, const Key* hashes,
+		const YaoEvalWire& left, const YaoEvalWire& right)
+{
+	bool sa = left.external();
+	bool sb = right.external();
+	int c = 2 * sa + sb;
+	int r = ((z >> (4 * c)) & 0xF) ^ pad(hashes[0], hashes[1], hashes[2]);
+	int R = eval_table[c][r];
+	Key A = left.key();
+	Key B = right.key();
+	uint64_t labels[4] = { low(A), high(A), low(B), high(B) };
+	uint64_t K = low(hashes[2]);
+	uint64_t out_low = low(hashes[0]) ^ K ^ select(R, labels);
+	uint64_t out_high = low(hashes[1]) ^ K ^ select(R >> 4, labels);
+	if (sa)
+	{
+		out_low ^= G[0] ^ G[2];
+		out_high ^= G[2];
+	}
+	if (sb)
+	{
+		out_low ^= G[2];
+		out_high ^= G[1] ^ G[2];
+	}
+	out.set(Key(out_high, out_low));
+}
+
+#endif /* YAO_YAOTHREEHALVESGATE_H_ */